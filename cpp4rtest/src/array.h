@@ -0,0 +1,103 @@
+/* roxygen
+@title Fill a 4-D Array on 'C++' Side
+@description Test suite
+@param d1,d2,d3,d4 extents of the array
+@export
+*/
+[[cpp4r::register]] cpp4r::writable::array<double, 4> array_fill_(int d1, int d2, int d3,
+                                                                  int d4) {
+  cpp4r::writable::array<double, 4> x({d1, d2, d3, d4});
+  for (int l = 0; l < d4; ++l) {
+    for (int k = 0; k < d3; ++k) {
+      for (int j = 0; j < d2; ++j) {
+        for (int i = 0; i < d1; ++i) {
+          x(i, j, k, l) = i + 10 * j + 100 * k + 1000 * l;
+        }
+      }
+    }
+  }
+  return x;
+}
+
+/* roxygen
+@title Slice a 3-D Array along an Axis on 'C++' Side
+@description Test suite
+@param x 3-D array of doubles (R)
+@param axis 0-based axis to slice along
+@param index 0-based position along `axis`
+@export
+*/
+[[cpp4r::register]] cpp4r::writable::array<double, 2> array_slice_(
+    cpp4r::array<double, 3> x, int axis, int index) {
+  auto slice = x.slice(axis, index);
+  cpp4r::writable::array<double, 2> out(
+      {static_cast<int>(slice.extent(0)), static_cast<int>(slice.extent(1))});
+  slice.for_each([&](const std::array<R_xlen_t, 2>& i, double value) {
+    out(i[0], i[1]) = value;
+  });
+  return out;
+}
+
+/* roxygen
+@title Sum a 3-D Array over Axes on 'C++' Side
+@description Test suite
+@param x 3-D array of doubles (R)
+@param axes 0-based axes to sum over
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles array_sum_(cpp4r::array<double, 3> x,
+                                              std::vector<int> axes) {
+  return x.sum(axes);
+}
+
+/* roxygen
+@title Average a 3-D Array over Axes on 'C++' Side
+@description Test suite
+@param x 3-D array of doubles (R)
+@param axes 0-based axes to average over
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles array_mean_(cpp4r::array<double, 3> x,
+                                               std::vector<int> axes) {
+  return x.mean(axes);
+}
+
+/* roxygen
+@title Maximum of a Window of a 3-D Array over its First Axis on 'C++' Side
+@description Test suite
+@param x 3-D array of integers (R)
+@param start 0-based first position along the last axis
+@param length number of positions along the last axis
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles array_window_max_(cpp4r::array<int, 3> x, int start,
+                                                     int length) {
+  return x.sub(2, start, length).reduce({0}, R_NegInf, [](double acc, double value) {
+    return value > acc ? value : acc;
+  });
+}
+
+/* R code to benchmark sums over axes against apply() and rowSums()
+res <- bench::press(
+  n = c(20, 100, 200),
+  {
+    x <- array(stats::runif(n * n * n), c(n, n, n))
+    bench::mark(
+      apply(x, c(1, 3), sum),
+      array_sum_(x, 1L)
+    )
+  }
+)
+
+res_all <- bench::press(
+  n = c(20, 100, 200),
+  {
+    x <- array(stats::runif(n * n * n), c(n, n, n))
+    bench::mark(
+      apply(x, 1, sum),
+      rowSums(x),
+      array_sum_(x, c(1L, 2L))
+    )
+  }
+)
+*/
@@ -0,0 +1,124 @@
+[[cpp4r::init]] void init_arrow_vectors(DllInfo* dll) {
+  cpp4r::init_arrow(dll, "cpp4rtest");
+}
+
+/* roxygen
+@title Round Trip Through the Arrow C Data Interface on 'C++' Side
+@description Test suite
+@param x double, integer or raw vector, or data frame of them
+@export
+*/
+[[cpp4r::register]] SEXP arrow_roundtrip_(SEXP x) {
+  ArrowArray array;
+  ArrowSchema schema;
+  cpp4r::export_arrow(x, &array, &schema);
+  cpp4r::sexp out = cpp4r::import_arrow(&array, &schema);
+  schema.release(&schema);
+  return out;
+}
+
+/* roxygen
+@title Check an Arrow Round Trip Shares Memory on 'C++' Side
+@description Test suite
+@param x double, integer or raw vector
+@export
+*/
+[[cpp4r::register]] bool arrow_shares_memory_(SEXP x) {
+  ArrowArray array;
+  ArrowSchema schema;
+  cpp4r::export_arrow(x, &array, &schema);
+  const void* exported = array.buffers[1];
+  cpp4r::sexp out = cpp4r::import_arrow(&array, &schema);
+  schema.release(&schema);
+  return exported == DATAPTR_RO(x) && DATAPTR_OR_NULL(out) == exported;
+}
+
+// An Arrow array owning its buffers
+template <typename T>
+struct arrow_test_data {
+  std::vector<T> values;
+  std::vector<uint8_t> validity;
+  const void* buffers[2];
+};
+
+// Imports `values[offset:]` as an Arrow array of `format` with the nulls in `valid`
+template <typename T, typename V>
+SEXP import_with_nulls(const V& values, cpp4r::logicals valid, int offset,
+                       const char* format) {
+  auto* data = new arrow_test_data<T>();
+  data->values.assign(values.begin(), values.end());
+  data->validity.assign((values.size() + 7) / 8, 0);
+  int64_t nulls = 0;
+  for (R_xlen_t i = 0; i < valid.size(); ++i) {
+    if (valid[i] == TRUE) {
+      data->validity[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+    } else if (i >= offset) {
+      ++nulls;
+    }
+  }
+  data->buffers[0] = data->validity.data();
+  data->buffers[1] = data->values.data();
+
+  ArrowArray array;
+  array.length = values.size() - offset;
+  array.null_count = nulls;
+  array.offset = offset;
+  array.n_buffers = 2;
+  array.n_children = 0;
+  array.buffers = data->buffers;
+  array.children = nullptr;
+  array.dictionary = nullptr;
+  array.release = [](ArrowArray* self) {
+    delete static_cast<arrow_test_data<T>*>(self->private_data);
+    self->release = nullptr;
+  };
+  array.private_data = data;
+
+  ArrowSchema schema = {format,  "",      nullptr, ARROW_FLAG_NULLABLE, 0,
+                        nullptr, nullptr, nullptr, nullptr};
+  return cpp4r::import_arrow(&array, &schema);
+}
+
+/* roxygen
+@title Import an Arrow Array with Nulls on 'C++' Side
+@description Test suite
+@param values integer values
+@param valid whether each value is valid
+@param offset offset of the array into its buffers
+@export
+*/
+[[cpp4r::register]] SEXP arrow_import_int32_(cpp4r::integers values,
+                                             cpp4r::logicals valid, int offset) {
+  return import_with_nulls<int>(values, valid, offset, "i");
+}
+
+/* roxygen
+@title Import an Arrow Array of Bytes with Nulls on 'C++' Side
+@description Test suite
+@param values bytes
+@param valid whether each byte is valid
+@param offset offset of the array into its buffers
+@export
+*/
+[[cpp4r::register]] SEXP arrow_import_uint8_(cpp4r::raws values, cpp4r::logicals valid,
+                                             int offset) {
+  return import_with_nulls<uint8_t>(values, valid, offset, "C");
+}
+
+/* roxygen
+@title Check a Vector Has a Data Pointer on 'C++' Side
+@description Test suite
+@param x vector
+@export
+*/
+[[cpp4r::register]] bool has_dataptr_(SEXP x) { return DATAPTR_OR_NULL(x) != nullptr; }
+
+/* R code to benchmark exporting and importing 100 MB of doubles
+x <- runif(12.5e6)
+df <- data.frame(x = x, y = seq_along(x))
+bench::mark(
+  arrow_roundtrip_(x),
+  arrow_roundtrip_(df),
+  check = FALSE
+)
+*/
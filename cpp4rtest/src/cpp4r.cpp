@@ -12,6 +12,76 @@ extern "C" SEXP _cpp4rtest_add_vec_for_(SEXP x, SEXP num) {
     return cpp4r::as_sexp(add_vec_for_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::writable::doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<double>>(num)));
   END_CPP4R
 }
+// array.h
+cpp4r::writable::array<double, 4> array_fill_(int d1, int d2, int d3, int d4);
+extern "C" SEXP _cpp4rtest_array_fill_(SEXP d1, SEXP d2, SEXP d3, SEXP d4) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(array_fill_(cpp4r::as_cpp<cpp4r::decay_t<int>>(d1), cpp4r::as_cpp<cpp4r::decay_t<int>>(d2), cpp4r::as_cpp<cpp4r::decay_t<int>>(d3), cpp4r::as_cpp<cpp4r::decay_t<int>>(d4)));
+  END_CPP4R
+}
+// array.h
+cpp4r::writable::array<double, 2> array_slice_(cpp4r::array<double, 3> x, int axis, int index);
+extern "C" SEXP _cpp4rtest_array_slice_(SEXP x, SEXP axis, SEXP index) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(array_slice_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::array<double, 3>>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(axis), cpp4r::as_cpp<cpp4r::decay_t<int>>(index)));
+  END_CPP4R
+}
+// array.h
+cpp4r::doubles array_sum_(cpp4r::array<double, 3> x, std::vector<int> axes);
+extern "C" SEXP _cpp4rtest_array_sum_(SEXP x, SEXP axes) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(array_sum_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::array<double, 3>>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::vector<int>>>(axes)));
+  END_CPP4R
+}
+// array.h
+cpp4r::doubles array_mean_(cpp4r::array<double, 3> x, std::vector<int> axes);
+extern "C" SEXP _cpp4rtest_array_mean_(SEXP x, SEXP axes) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(array_mean_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::array<double, 3>>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::vector<int>>>(axes)));
+  END_CPP4R
+}
+// array.h
+cpp4r::doubles array_window_max_(cpp4r::array<int, 3> x, int start, int length);
+extern "C" SEXP _cpp4rtest_array_window_max_(SEXP x, SEXP start, SEXP length) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(array_window_max_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::array<int, 3>>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(start), cpp4r::as_cpp<cpp4r::decay_t<int>>(length)));
+  END_CPP4R
+}
+// arrow.h
+SEXP arrow_roundtrip_(SEXP x);
+extern "C" SEXP _cpp4rtest_arrow_roundtrip_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(arrow_roundtrip_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x)));
+  END_CPP4R
+}
+// arrow.h
+bool arrow_shares_memory_(SEXP x);
+extern "C" SEXP _cpp4rtest_arrow_shares_memory_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(arrow_shares_memory_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x)));
+  END_CPP4R
+}
+// arrow.h
+SEXP arrow_import_int32_(cpp4r::integers values, cpp4r::logicals valid, int offset);
+extern "C" SEXP _cpp4rtest_arrow_import_int32_(SEXP values, SEXP valid, SEXP offset) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(arrow_import_int32_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::integers>>(values), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::logicals>>(valid), cpp4r::as_cpp<cpp4r::decay_t<int>>(offset)));
+  END_CPP4R
+}
+// arrow.h
+SEXP arrow_import_uint8_(cpp4r::raws values, cpp4r::logicals valid, int offset);
+extern "C" SEXP _cpp4rtest_arrow_import_uint8_(SEXP values, SEXP valid, SEXP offset) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(arrow_import_uint8_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::raws>>(values), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::logicals>>(valid), cpp4r::as_cpp<cpp4r::decay_t<int>>(offset)));
+  END_CPP4R
+}
+// arrow.h
+bool has_dataptr_(SEXP x);
+extern "C" SEXP _cpp4rtest_has_dataptr_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(has_dataptr_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x)));
+  END_CPP4R
+}
 // data_frame.h
 SEXP data_frame_();
 extern "C" SEXP _cpp4rtest_data_frame_() {
@@ -19,6 +89,34 @@ extern "C" SEXP _cpp4rtest_data_frame_() {
     return cpp4r::as_sexp(data_frame_());
   END_CPP4R
 }
+// data_frame.h
+double df_of_total_(SEXP x);
+extern "C" SEXP _cpp4rtest_df_of_total_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(df_of_total_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x)));
+  END_CPP4R
+}
+// data_frame.h
+cpp4r::strings df_of_rows_(SEXP x);
+extern "C" SEXP _cpp4rtest_df_of_rows_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(df_of_rows_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x)));
+  END_CPP4R
+}
+// data_frame.h
+double df_of_rows_total_(SEXP x, std::string item);
+extern "C" SEXP _cpp4rtest_df_of_rows_total_(SEXP x, SEXP item) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(df_of_rows_total_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(item)));
+  END_CPP4R
+}
+// data_frame.h
+SEXP df_builder_(int n, bool reserve);
+extern "C" SEXP _cpp4rtest_df_builder_(SEXP n, SEXP reserve) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(df_builder_(cpp4r::as_cpp<cpp4r::decay_t<int>>(n), cpp4r::as_cpp<cpp4r::decay_t<bool>>(reserve)));
+  END_CPP4R
+}
 // env-helpers.h
 int env_get_int_(environment env, std::string name);
 extern "C" SEXP _cpp4rtest_env_get_int_(SEXP env, SEXP name) {
@@ -104,6 +202,42 @@ extern "C" SEXP _cpp4rtest_find_name_pos_(SEXP x, SEXP name) {
     return cpp4r::as_sexp(find_name_pos_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(name)));
   END_CPP4R
 }
+// env-helpers.h
+double env_sum_x_(environment env, int n, bool cached);
+extern "C" SEXP _cpp4rtest_env_sum_x_(SEXP env, SEXP n, SEXP cached) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(env_sum_x_(cpp4r::as_cpp<cpp4r::decay_t<environment>>(env), cpp4r::as_cpp<cpp4r::decay_t<int>>(n), cpp4r::as_cpp<cpp4r::decay_t<bool>>(cached)));
+  END_CPP4R
+}
+// env-helpers.h
+double symbol_call_(doubles x);
+extern "C" SEXP _cpp4rtest_symbol_call_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(symbol_call_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x)));
+  END_CPP4R
+}
+// env-helpers.h
+double env_bindings_sum_(environment env);
+extern "C" SEXP _cpp4rtest_env_bindings_sum_(SEXP env) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(env_bindings_sum_(cpp4r::as_cpp<cpp4r::decay_t<environment>>(env)));
+  END_CPP4R
+}
+// env-helpers.h
+SEXP env_get_many_(environment env, strings names, bool missing);
+extern "C" SEXP _cpp4rtest_env_get_many_(SEXP env, SEXP names, SEXP missing) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(env_get_many_(cpp4r::as_cpp<cpp4r::decay_t<environment>>(env), cpp4r::as_cpp<cpp4r::decay_t<strings>>(names), cpp4r::as_cpp<cpp4r::decay_t<bool>>(missing)));
+  END_CPP4R
+}
+// env-helpers.h
+void env_assign_many_(environment env, list values);
+extern "C" SEXP _cpp4rtest_env_assign_many_(SEXP env, SEXP values) {
+  BEGIN_CPP4R
+    env_assign_many_(cpp4r::as_cpp<cpp4r::decay_t<environment>>(env), cpp4r::as_cpp<cpp4r::decay_t<list>>(values));
+    return R_NilValue;
+  END_CPP4R
+}
 // errors.h
 void my_stop_n1_(std::string mystring);
 extern "C" SEXP _cpp4rtest_my_stop_n1_(SEXP mystring) {
@@ -166,6 +300,42 @@ extern "C" SEXP _cpp4rtest_nullable_extptr_2() {
     return cpp4r::as_sexp(nullable_extptr_2());
   END_CPP4R
 }
+// external-pointers.h
+cpp4r::list make_nodes_(int n, bool pooled);
+extern "C" SEXP _cpp4rtest_make_nodes_(SEXP n, SEXP pooled) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(make_nodes_(cpp4r::as_cpp<cpp4r::decay_t<int>>(n), cpp4r::as_cpp<cpp4r::decay_t<bool>>(pooled)));
+  END_CPP4R
+}
+// external-pointers.h
+double sum_pooled_nodes_(cpp4r::list nodes);
+extern "C" SEXP _cpp4rtest_sum_pooled_nodes_(SEXP nodes) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(sum_pooled_nodes_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::list>>(nodes)));
+  END_CPP4R
+}
+// external-pointers.h
+void reset_pooled_node_(SEXP node);
+extern "C" SEXP _cpp4rtest_reset_pooled_node_(SEXP node) {
+  BEGIN_CPP4R
+    reset_pooled_node_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(node));
+    return R_NilValue;
+  END_CPP4R
+}
+// external-pointers.h
+SEXP linear_model_(std::string label, cpp4r::doubles weights);
+extern "C" SEXP _cpp4rtest_linear_model_(SEXP label, SEXP weights) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(linear_model_(cpp4r::as_cpp<cpp4r::decay_t<std::string>>(label), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::doubles>>(weights)));
+  END_CPP4R
+}
+// external-pointers.h
+cpp4r::list linear_model_info_(SEXP model);
+extern "C" SEXP _cpp4rtest_linear_model_info_(SEXP model) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(linear_model_info_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(model)));
+  END_CPP4R
+}
 // find-intervals.h
 SEXP remove_altrep(SEXP x);
 extern "C" SEXP _cpp4rtest_remove_altrep(SEXP x) {
@@ -201,6 +371,62 @@ extern "C" SEXP _cpp4rtest_findInterval3(SEXP x, SEXP breaks) {
     return cpp4r::as_sexp(findInterval3(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<doubles>>(breaks)));
   END_CPP4R
 }
+// find-intervals.h
+integers findInterval4(doubles x, doubles breaks, bool rightmost_closed, bool all_inside, bool left_open);
+extern "C" SEXP _cpp4rtest_findInterval4(SEXP x, SEXP breaks, SEXP rightmost_closed, SEXP all_inside, SEXP left_open) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(findInterval4(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<doubles>>(breaks), cpp4r::as_cpp<cpp4r::decay_t<bool>>(rightmost_closed), cpp4r::as_cpp<cpp4r::decay_t<bool>>(all_inside), cpp4r::as_cpp<cpp4r::decay_t<bool>>(left_open)));
+  END_CPP4R
+}
+// function.h
+double call_repeatedly_(SEXP fn, int n, bool prepared);
+extern "C" SEXP _cpp4rtest_call_repeatedly_(SEXP fn, SEXP n, SEXP prepared) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(call_repeatedly_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(fn), cpp4r::as_cpp<cpp4r::decay_t<int>>(n), cpp4r::as_cpp<cpp4r::decay_t<bool>>(prepared)));
+  END_CPP4R
+}
+// function.h
+cpp4r::doubles call_vector_repeatedly_(SEXP fn, cpp4r::doubles x, int n);
+extern "C" SEXP _cpp4rtest_call_vector_repeatedly_(SEXP fn, SEXP x, SEXP n) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(call_vector_repeatedly_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(fn), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(n)));
+  END_CPP4R
+}
+// function.h
+SEXP map_batch_(SEXP fn, SEXP x, int batch_size);
+extern "C" SEXP _cpp4rtest_map_batch_(SEXP fn, SEXP x, SEXP batch_size) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(map_batch_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(fn), cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(batch_size)));
+  END_CPP4R
+}
+// function.h
+SEXP map_batch_strings_(SEXP fn, cpp4r::strings x, int batch_size);
+extern "C" SEXP _cpp4rtest_map_batch_strings_(SEXP fn, SEXP x, SEXP batch_size) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(map_batch_strings_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(fn), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(batch_size)));
+  END_CPP4R
+}
+// group_by.h
+SEXP group_summary_(SEXP x, std::string key, std::string value, bool parallel);
+extern "C" SEXP _cpp4rtest_group_summary_(SEXP x, SEXP key, SEXP value, SEXP parallel) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(group_summary_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(key), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(value), cpp4r::as_cpp<cpp4r::decay_t<bool>>(parallel)));
+  END_CPP4R
+}
+// group_by.h
+SEXP group_first_last_(SEXP x, std::string key1, std::string key2, std::string value);
+extern "C" SEXP _cpp4rtest_group_first_last_(SEXP x, SEXP key1, SEXP key2, SEXP value) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(group_first_last_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(key1), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(key2), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(value)));
+  END_CPP4R
+}
+// group_by.h
+cpp4r::integers group_ids_(SEXP x, std::string key);
+extern "C" SEXP _cpp4rtest_group_ids_(SEXP x, SEXP key) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(group_ids_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(key)));
+  END_CPP4R
+}
 // grow.h
 cpp4r::writable::doubles grow_(R_xlen_t n);
 extern "C" SEXP _cpp4rtest_grow_(SEXP n) {
@@ -222,6 +448,104 @@ extern "C" SEXP _cpp4rtest_insert_(SEXP num_sxp) {
     return cpp4r::as_sexp(insert_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(num_sxp)));
   END_CPP4R
 }
+// join.h
+SEXP join_(SEXP x, SEXP y, cpp4r::strings by, std::string type);
+extern "C" SEXP _cpp4rtest_join_(SEXP x, SEXP y, SEXP by, SEXP type) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(join_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(y), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::strings>>(by), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(type)));
+  END_CPP4R
+}
+// join.h
+cpp4r::list join_rows_(SEXP x, SEXP y, cpp4r::strings by, std::string type);
+extern "C" SEXP _cpp4rtest_join_rows_(SEXP x, SEXP y, SEXP by, SEXP type) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(join_rows_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(y), cpp4r::as_cpp<cpp4r::decay_t<cpp4r::strings>>(by), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(type)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> matmul_(doubles_matrix<> a, doubles_matrix<> b, bool trans_a, bool trans_b);
+extern "C" SEXP _cpp4rtest_matmul_(SEXP a, SEXP b, SEXP trans_a, SEXP trans_b) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(matmul_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(b), cpp4r::as_cpp<cpp4r::decay_t<bool>>(trans_a), cpp4r::as_cpp<cpp4r::decay_t<bool>>(trans_b)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> matmul_block_(doubles_matrix<> a, doubles_matrix<> b, int k);
+extern "C" SEXP _cpp4rtest_matmul_block_(SEXP a, SEXP b, SEXP k) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(matmul_block_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(b), cpp4r::as_cpp<cpp4r::decay_t<int>>(k)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> crossprod_(doubles_matrix<> a, bool trans);
+extern "C" SEXP _cpp4rtest_crossprod_(SEXP a, SEXP trans) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(crossprod_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a), cpp4r::as_cpp<cpp4r::decay_t<bool>>(trans)));
+  END_CPP4R
+}
+// linalg.h
+doubles matvec_(doubles_matrix<> a, doubles x, bool trans);
+extern "C" SEXP _cpp4rtest_matvec_(SEXP a, SEXP x, SEXP trans) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(matvec_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a), cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(trans)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> chol_(doubles_matrix<> a);
+extern "C" SEXP _cpp4rtest_chol_(SEXP a) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(chol_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> chol_solve_(doubles_matrix<> a, doubles_matrix<> b);
+extern "C" SEXP _cpp4rtest_chol_solve_(SEXP a, SEXP b) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(chol_solve_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(b)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> lu_solve_(doubles_matrix<> a, doubles_matrix<> b, bool trans);
+extern "C" SEXP _cpp4rtest_lu_solve_(SEXP a, SEXP b, SEXP trans) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(lu_solve_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(b), cpp4r::as_cpp<cpp4r::decay_t<bool>>(trans)));
+  END_CPP4R
+}
+// linalg.h
+list qr_(doubles_matrix<> a);
+extern "C" SEXP _cpp4rtest_qr_(SEXP a) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(qr_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(a)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> ols_naive_(doubles_matrix<> X, doubles_matrix<> Y);
+extern "C" SEXP _cpp4rtest_ols_naive_(SEXP X, SEXP Y) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(ols_naive_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(X), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(Y)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> ols_blas_(doubles_matrix<> X, doubles_matrix<> Y);
+extern "C" SEXP _cpp4rtest_ols_blas_(SEXP X, SEXP Y) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(ols_blas_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(X), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(Y)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> invert_gauss_jordan_(doubles_matrix<> A);
+extern "C" SEXP _cpp4rtest_invert_gauss_jordan_(SEXP A) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(invert_gauss_jordan_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(A)));
+  END_CPP4R
+}
+// linalg.h
+doubles_matrix<> invert_lapack_(doubles_matrix<> A);
+extern "C" SEXP _cpp4rtest_invert_lapack_(SEXP A) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(invert_lapack_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(A)));
+  END_CPP4R
+}
 // list-complex-helpers.h
 list_of<doubles> list_of_doubles_();
 extern "C" SEXP _cpp4rtest_list_of_doubles_() {
@@ -335,6 +659,55 @@ extern "C" SEXP _cpp4rtest_row_sums_(SEXP x) {
   END_CPP4R
 }
 // matrix.h
+cpp4r::doubles row_sums_tiled_(cpp4r::doubles_matrix<> x, int tile_rows);
+extern "C" SEXP _cpp4rtest_row_sums_tiled_(SEXP x, SEXP tile_rows) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(row_sums_tiled_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::doubles_matrix<>>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(tile_rows)));
+  END_CPP4R
+}
+// matrix.h
+cpp4r::doubles_matrix<> transpose_dbl_(cpp4r::doubles_matrix<> x);
+extern "C" SEXP _cpp4rtest_transpose_dbl_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(transpose_dbl_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::doubles_matrix<>>>(x)));
+  END_CPP4R
+}
+// matrix.h
+cpp4r::strings_matrix<> transpose_chr_(cpp4r::strings_matrix<> x);
+extern "C" SEXP _cpp4rtest_transpose_chr_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(transpose_chr_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::strings_matrix<>>>(x)));
+  END_CPP4R
+}
+// matrix.h
+cpp4r::integers int_matrix_corners_(cpp4r::integers_matrix<> x);
+extern "C" SEXP _cpp4rtest_int_matrix_corners_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(int_matrix_corners_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::integers_matrix<>>>(x)));
+  END_CPP4R
+}
+// matrix.h
+cpp4r::doubles int_matrix_last_sums_(cpp4r::integers_matrix<> x);
+extern "C" SEXP _cpp4rtest_int_matrix_last_sums_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(int_matrix_last_sums_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::integers_matrix<>>>(x)));
+  END_CPP4R
+}
+// matrix.h
+cpp4r::doubles_matrix<> block_transpose_(cpp4r::doubles_matrix<> x, int row, int col, int nrow, int ncol);
+extern "C" SEXP _cpp4rtest_block_transpose_(SEXP x, SEXP row, SEXP col, SEXP nrow, SEXP ncol) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(block_transpose_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::doubles_matrix<>>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(row), cpp4r::as_cpp<cpp4r::decay_t<int>>(col), cpp4r::as_cpp<cpp4r::decay_t<int>>(nrow), cpp4r::as_cpp<cpp4r::decay_t<int>>(ncol)));
+  END_CPP4R
+}
+// matrix.h
+double block_inner_sum_(cpp4r::doubles_matrix<> x, int row, int col, int nrow, int ncol);
+extern "C" SEXP _cpp4rtest_block_inner_sum_(SEXP x, SEXP row, SEXP col, SEXP nrow, SEXP ncol) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(block_inner_sum_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::doubles_matrix<>>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(row), cpp4r::as_cpp<cpp4r::decay_t<int>>(col), cpp4r::as_cpp<cpp4r::decay_t<int>>(nrow), cpp4r::as_cpp<cpp4r::decay_t<int>>(ncol)));
+  END_CPP4R
+}
+// matrix.h
 cpp4r::doubles_matrix<> mat_mat_copy_dimnames_(cpp4r::doubles_matrix<> x);
 extern "C" SEXP _cpp4rtest_mat_mat_copy_dimnames_(SEXP x) {
   BEGIN_CPP4R
@@ -363,6 +736,20 @@ extern "C" SEXP _cpp4rtest_col_sums_(SEXP x) {
   END_CPP4R
 }
 // matrix.h
+cpp4r::doubles col_sums_coercing_(cpp4r::coercing_doubles_matrix x);
+extern "C" SEXP _cpp4rtest_col_sums_coercing_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(col_sums_coercing_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::coercing_doubles_matrix>>(x)));
+  END_CPP4R
+}
+// matrix.h
+double trace_coercing_(cpp4r::coercing_doubles_matrix x);
+extern "C" SEXP _cpp4rtest_trace_coercing_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(trace_coercing_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::coercing_doubles_matrix>>(x)));
+  END_CPP4R
+}
+// matrix.h
 cpp4r::doubles_matrix<> matrix_add_(const cpp4r::doubles_matrix<>& x, const cpp4r::doubles_matrix<>& y);
 extern "C" SEXP _cpp4rtest_matrix_add_(SEXP x, SEXP y) {
   BEGIN_CPP4R
@@ -469,6 +856,20 @@ extern "C" SEXP _cpp4rtest_protect_many_preserve_(SEXP n) {
     return R_NilValue;
   END_CPP4R
 }
+// raw_streams.h
+cpp4r::raws raw_stream_write_(double n, int chunk, bool stringstream);
+extern "C" SEXP _cpp4rtest_raw_stream_write_(SEXP n, SEXP chunk, SEXP stringstream) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(raw_stream_write_(cpp4r::as_cpp<cpp4r::decay_t<double>>(n), cpp4r::as_cpp<cpp4r::decay_t<int>>(chunk), cpp4r::as_cpp<cpp4r::decay_t<bool>>(stringstream)));
+  END_CPP4R
+}
+// raw_streams.h
+double raw_stream_sum_(cpp4r::raws x, int chunk, double skip);
+extern "C" SEXP _cpp4rtest_raw_stream_sum_(SEXP x, SEXP chunk, SEXP skip) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(raw_stream_sum_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::raws>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(chunk), cpp4r::as_cpp<cpp4r::decay_t<double>>(skip)));
+  END_CPP4R
+}
 // release.h
 void release_(int n);
 extern "C" SEXP _cpp4rtest_release_(SEXP n) {
@@ -477,6 +878,48 @@ extern "C" SEXP _cpp4rtest_release_(SEXP n) {
     return R_NilValue;
   END_CPP4R
 }
+// rolling.h
+doubles roll_sum_(doubles x, int width, std::string align, bool na_rm, bool partial);
+extern "C" SEXP _cpp4rtest_roll_sum_(SEXP x, SEXP width, SEXP align, SEXP na_rm, SEXP partial) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(roll_sum_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(width), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(align), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_rm), cpp4r::as_cpp<cpp4r::decay_t<bool>>(partial)));
+  END_CPP4R
+}
+// rolling.h
+doubles roll_mean_(doubles x, int width, std::string align, bool na_rm, bool partial);
+extern "C" SEXP _cpp4rtest_roll_mean_(SEXP x, SEXP width, SEXP align, SEXP na_rm, SEXP partial) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(roll_mean_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(width), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(align), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_rm), cpp4r::as_cpp<cpp4r::decay_t<bool>>(partial)));
+  END_CPP4R
+}
+// rolling.h
+doubles roll_var_(doubles x, int width, std::string align, bool na_rm, bool partial);
+extern "C" SEXP _cpp4rtest_roll_var_(SEXP x, SEXP width, SEXP align, SEXP na_rm, SEXP partial) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(roll_var_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(width), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(align), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_rm), cpp4r::as_cpp<cpp4r::decay_t<bool>>(partial)));
+  END_CPP4R
+}
+// rolling.h
+doubles roll_min_(doubles x, int width, std::string align, bool na_rm, bool partial);
+extern "C" SEXP _cpp4rtest_roll_min_(SEXP x, SEXP width, SEXP align, SEXP na_rm, SEXP partial) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(roll_min_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(width), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(align), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_rm), cpp4r::as_cpp<cpp4r::decay_t<bool>>(partial)));
+  END_CPP4R
+}
+// rolling.h
+doubles roll_max_(doubles x, int width, std::string align, bool na_rm, bool partial);
+extern "C" SEXP _cpp4rtest_roll_max_(SEXP x, SEXP width, SEXP align, SEXP na_rm, SEXP partial) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(roll_max_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(width), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(align), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_rm), cpp4r::as_cpp<cpp4r::decay_t<bool>>(partial)));
+  END_CPP4R
+}
+// rolling.h
+doubles roll_median_(doubles x, int width, std::string align, bool na_rm, bool partial);
+extern "C" SEXP _cpp4rtest_roll_median_(SEXP x, SEXP width, SEXP align, SEXP na_rm, SEXP partial) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(roll_median_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(width), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(align), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_rm), cpp4r::as_cpp<cpp4r::decay_t<bool>>(partial)));
+  END_CPP4R
+}
 // safe.h
 SEXP safe_(SEXP x_sxp);
 extern "C" SEXP _cpp4rtest_safe_(SEXP x_sxp) {
@@ -484,6 +927,42 @@ extern "C" SEXP _cpp4rtest_safe_(SEXP x_sxp) {
     return cpp4r::as_sexp(safe_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x_sxp)));
   END_CPP4R
 }
+// serialize.h
+cpp4r::raws serialize_raw_(SEXP x, bool native);
+extern "C" SEXP _cpp4rtest_serialize_raw_(SEXP x, SEXP native) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(serialize_raw_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(native)));
+  END_CPP4R
+}
+// serialize.h
+SEXP unserialize_raw_(cpp4r::raws x);
+extern "C" SEXP _cpp4rtest_unserialize_raw_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(unserialize_raw_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::raws>>(x)));
+  END_CPP4R
+}
+// serialize.h
+void serialize_file_(SEXP x, std::string path, bool native);
+extern "C" SEXP _cpp4rtest_serialize_file_(SEXP x, SEXP path, SEXP native) {
+  BEGIN_CPP4R
+    serialize_file_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<std::string>>(path), cpp4r::as_cpp<cpp4r::decay_t<bool>>(native));
+    return R_NilValue;
+  END_CPP4R
+}
+// serialize.h
+SEXP unserialize_file_(std::string path);
+extern "C" SEXP _cpp4rtest_unserialize_file_(SEXP path) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(unserialize_file_(cpp4r::as_cpp<cpp4r::decay_t<std::string>>(path)));
+  END_CPP4R
+}
+// serialize.h
+cpp4r::doubles serialize_callback_(SEXP x, int chunk);
+extern "C" SEXP _cpp4rtest_serialize_callback_(SEXP x, SEXP chunk) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(serialize_callback_(cpp4r::as_cpp<cpp4r::decay_t<SEXP>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(chunk)));
+  END_CPP4R
+}
 // sexp_helpers.h
 list sexp_list_init_();
 extern "C" SEXP _cpp4rtest_sexp_list_init_() {
@@ -498,6 +977,55 @@ extern "C" SEXP _cpp4rtest_sexp_scalar_list_init_() {
     return cpp4r::as_sexp(sexp_scalar_list_init_());
   END_CPP4R
 }
+// sort.h
+integers order_dbl_(doubles x, bool decreasing, bool na_last);
+extern "C" SEXP _cpp4rtest_order_dbl_(SEXP x, SEXP decreasing, SEXP na_last) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(order_dbl_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_last)));
+  END_CPP4R
+}
+// sort.h
+integers order_int_(integers x, bool decreasing, bool na_last);
+extern "C" SEXP _cpp4rtest_order_int_(SEXP x, SEXP decreasing, SEXP na_last) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(order_int_(cpp4r::as_cpp<cpp4r::decay_t<integers>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_last)));
+  END_CPP4R
+}
+// sort.h
+integers order_lgl_(logicals x, bool decreasing, bool na_last);
+extern "C" SEXP _cpp4rtest_order_lgl_(SEXP x, SEXP decreasing, SEXP na_last) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(order_lgl_(cpp4r::as_cpp<cpp4r::decay_t<logicals>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_last)));
+  END_CPP4R
+}
+// sort.h
+integers order_chr_(strings x, bool decreasing, bool na_last, bool c_locale);
+extern "C" SEXP _cpp4rtest_order_chr_(SEXP x, SEXP decreasing, SEXP na_last, SEXP c_locale) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(order_chr_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing), cpp4r::as_cpp<cpp4r::decay_t<bool>>(na_last), cpp4r::as_cpp<cpp4r::decay_t<bool>>(c_locale)));
+  END_CPP4R
+}
+// sort.h
+doubles sort_dbl_(doubles x, bool decreasing);
+extern "C" SEXP _cpp4rtest_sort_dbl_(SEXP x, SEXP decreasing) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(sort_dbl_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing)));
+  END_CPP4R
+}
+// sort.h
+integers sort_int_(integers x, bool decreasing);
+extern "C" SEXP _cpp4rtest_sort_int_(SEXP x, SEXP decreasing) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(sort_int_(cpp4r::as_cpp<cpp4r::decay_t<integers>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing)));
+  END_CPP4R
+}
+// sort.h
+strings sort_chr_(strings x, bool decreasing);
+extern "C" SEXP _cpp4rtest_sort_chr_(SEXP x, SEXP decreasing) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(sort_chr_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<bool>>(decreasing)));
+  END_CPP4R
+}
 // strings.h
 cpp4r::strings grow_strings_(size_t n, int seed);
 extern "C" SEXP _cpp4rtest_grow_strings_(SEXP n, SEXP seed) {
@@ -519,6 +1047,69 @@ extern "C" SEXP _cpp4rtest_assign_(SEXP n, SEXP seed) {
     return cpp4r::as_sexp(assign_(cpp4r::as_cpp<cpp4r::decay_t<size_t>>(n), cpp4r::as_cpp<cpp4r::decay_t<int>>(seed)));
   END_CPP4R
 }
+// subset.h
+doubles subset_dbl_(doubles x, integers idx);
+extern "C" SEXP _cpp4rtest_subset_dbl_(SEXP x, SEXP idx) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_dbl_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<integers>>(idx)));
+  END_CPP4R
+}
+// subset.h
+integers subset_int_(integers x, integers idx);
+extern "C" SEXP _cpp4rtest_subset_int_(SEXP x, SEXP idx) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_int_(cpp4r::as_cpp<cpp4r::decay_t<integers>>(x), cpp4r::as_cpp<cpp4r::decay_t<integers>>(idx)));
+  END_CPP4R
+}
+// subset.h
+strings subset_chr_(strings x, integers idx);
+extern "C" SEXP _cpp4rtest_subset_chr_(SEXP x, SEXP idx) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_chr_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<integers>>(idx)));
+  END_CPP4R
+}
+// subset.h
+doubles subset_mask_dbl_(doubles x, logicals mask);
+extern "C" SEXP _cpp4rtest_subset_mask_dbl_(SEXP x, SEXP mask) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_mask_dbl_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<logicals>>(mask)));
+  END_CPP4R
+}
+// subset.h
+logicals subset_mask_lgl_(logicals x, logicals mask);
+extern "C" SEXP _cpp4rtest_subset_mask_lgl_(SEXP x, SEXP mask) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_mask_lgl_(cpp4r::as_cpp<cpp4r::decay_t<logicals>>(x), cpp4r::as_cpp<cpp4r::decay_t<logicals>>(mask)));
+  END_CPP4R
+}
+// subset.h
+complexes subset_mask_cplx_(complexes x, logicals mask);
+extern "C" SEXP _cpp4rtest_subset_mask_cplx_(SEXP x, SEXP mask) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_mask_cplx_(cpp4r::as_cpp<cpp4r::decay_t<complexes>>(x), cpp4r::as_cpp<cpp4r::decay_t<logicals>>(mask)));
+  END_CPP4R
+}
+// subset.h
+raws subset_mask_raw_(raws x, logicals mask);
+extern "C" SEXP _cpp4rtest_subset_mask_raw_(SEXP x, SEXP mask) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(subset_mask_raw_(cpp4r::as_cpp<cpp4r::decay_t<raws>>(x), cpp4r::as_cpp<cpp4r::decay_t<logicals>>(mask)));
+  END_CPP4R
+}
+// subset.h
+doubles assign_at_dbl_(doubles x, integers idx, doubles values);
+extern "C" SEXP _cpp4rtest_assign_at_dbl_(SEXP x, SEXP idx, SEXP values) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(assign_at_dbl_(cpp4r::as_cpp<cpp4r::decay_t<doubles>>(x), cpp4r::as_cpp<cpp4r::decay_t<integers>>(idx), cpp4r::as_cpp<cpp4r::decay_t<doubles>>(values)));
+  END_CPP4R
+}
+// subset.h
+strings assign_at_chr_(strings x, integers idx, strings values);
+extern "C" SEXP _cpp4rtest_assign_at_chr_(SEXP x, SEXP idx, SEXP values) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(assign_at_chr_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<integers>>(idx), cpp4r::as_cpp<cpp4r::decay_t<strings>>(values)));
+  END_CPP4R
+}
 // sum.h
 double sum_dbl_for_(cpp4r::doubles x);
 extern "C" SEXP _cpp4rtest_sum_dbl_for_(SEXP x) {
@@ -765,6 +1356,48 @@ extern "C" SEXP _cpp4rtest_iterator_distance_(SEXP x) {
   END_CPP4R
 }
 // test-helpers.h
+writable::strings iterator_sort_strings_(strings x);
+extern "C" SEXP _cpp4rtest_iterator_sort_strings_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(iterator_sort_strings_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x)));
+  END_CPP4R
+}
+// test-helpers.h
+writable::logicals iterator_sort_logicals_(logicals x);
+extern "C" SEXP _cpp4rtest_iterator_sort_logicals_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(iterator_sort_logicals_(cpp4r::as_cpp<cpp4r::decay_t<logicals>>(x)));
+  END_CPP4R
+}
+// test-helpers.h
+writable::complexes iterator_sort_complexes_(complexes x);
+extern "C" SEXP _cpp4rtest_iterator_sort_complexes_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(iterator_sort_complexes_(cpp4r::as_cpp<cpp4r::decay_t<complexes>>(x)));
+  END_CPP4R
+}
+// test-helpers.h
+r_string iterator_nth_string_(strings x, int n);
+extern "C" SEXP _cpp4rtest_iterator_nth_string_(SEXP x, SEXP n) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(iterator_nth_string_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(n)));
+  END_CPP4R
+}
+// test-helpers.h
+writable::list iterator_reverse_list_(list x);
+extern "C" SEXP _cpp4rtest_iterator_reverse_list_(SEXP x) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(iterator_reverse_list_(cpp4r::as_cpp<cpp4r::decay_t<list>>(x)));
+  END_CPP4R
+}
+// test-helpers.h
+r_string iterator_string_at_(strings x, int index);
+extern "C" SEXP _cpp4rtest_iterator_string_at_(SEXP x, SEXP index) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(iterator_string_at_(cpp4r::as_cpp<cpp4r::decay_t<strings>>(x), cpp4r::as_cpp<cpp4r::decay_t<int>>(index)));
+  END_CPP4R
+}
+// test-helpers.h
 writable::raws raw_copy_(raws x);
 extern "C" SEXP _cpp4rtest_raw_copy_(SEXP x) {
   BEGIN_CPP4R
@@ -821,11 +1454,39 @@ extern "C" SEXP _cpp4rtest_weak_ref_rejects_vec_() {
     return R_NilValue;
   END_CPP4R
 }
+// weak_ref_helpers.h
+double memo_median_(cpp4r::environment env);
+extern "C" SEXP _cpp4rtest_memo_median_(SEXP env) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(memo_median_(cpp4r::as_cpp<cpp4r::decay_t<cpp4r::environment>>(env)));
+  END_CPP4R
+}
+// weak_ref_helpers.h
+cpp4r::integers memo_stats_(bool reset);
+extern "C" SEXP _cpp4rtest_memo_stats_(SEXP reset) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(memo_stats_(cpp4r::as_cpp<cpp4r::decay_t<bool>>(reset)));
+  END_CPP4R
+}
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_add_vec_for_", (DL_FUNC) &_cpp4rtest_add_vec_for_, 2},
+    {"_cpp4rtest_array_fill_", (DL_FUNC) &_cpp4rtest_array_fill_, 4},
+    {"_cpp4rtest_array_slice_", (DL_FUNC) &_cpp4rtest_array_slice_, 3},
+    {"_cpp4rtest_array_sum_", (DL_FUNC) &_cpp4rtest_array_sum_, 2},
+    {"_cpp4rtest_array_mean_", (DL_FUNC) &_cpp4rtest_array_mean_, 2},
+    {"_cpp4rtest_array_window_max_", (DL_FUNC) &_cpp4rtest_array_window_max_, 3},
+    {"_cpp4rtest_arrow_roundtrip_", (DL_FUNC) &_cpp4rtest_arrow_roundtrip_, 1},
+    {"_cpp4rtest_arrow_shares_memory_", (DL_FUNC) &_cpp4rtest_arrow_shares_memory_, 1},
+    {"_cpp4rtest_arrow_import_int32_", (DL_FUNC) &_cpp4rtest_arrow_import_int32_, 3},
+    {"_cpp4rtest_arrow_import_uint8_", (DL_FUNC) &_cpp4rtest_arrow_import_uint8_, 3},
+    {"_cpp4rtest_has_dataptr_", (DL_FUNC) &_cpp4rtest_has_dataptr_, 1},
     {"_cpp4rtest_data_frame_", (DL_FUNC) &_cpp4rtest_data_frame_, 0},
+    {"_cpp4rtest_df_of_total_", (DL_FUNC) &_cpp4rtest_df_of_total_, 1},
+    {"_cpp4rtest_df_of_rows_", (DL_FUNC) &_cpp4rtest_df_of_rows_, 1},
+    {"_cpp4rtest_df_of_rows_total_", (DL_FUNC) &_cpp4rtest_df_of_rows_total_, 2},
+    {"_cpp4rtest_df_builder_", (DL_FUNC) &_cpp4rtest_df_builder_, 2},
     {"_cpp4rtest_env_get_int_", (DL_FUNC) &_cpp4rtest_env_get_int_, 2},
     {"_cpp4rtest_env_get_str_", (DL_FUNC) &_cpp4rtest_env_get_str_, 2},
     {"_cpp4rtest_env_set_", (DL_FUNC) &_cpp4rtest_env_set_, 3},
@@ -838,6 +1499,11 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_get_by_name_", (DL_FUNC) &_cpp4rtest_get_by_name_, 2},
     {"_cpp4rtest_contains_name_", (DL_FUNC) &_cpp4rtest_contains_name_, 2},
     {"_cpp4rtest_find_name_pos_", (DL_FUNC) &_cpp4rtest_find_name_pos_, 2},
+    {"_cpp4rtest_env_sum_x_", (DL_FUNC) &_cpp4rtest_env_sum_x_, 3},
+    {"_cpp4rtest_symbol_call_", (DL_FUNC) &_cpp4rtest_symbol_call_, 1},
+    {"_cpp4rtest_env_bindings_sum_", (DL_FUNC) &_cpp4rtest_env_bindings_sum_, 1},
+    {"_cpp4rtest_env_get_many_", (DL_FUNC) &_cpp4rtest_env_get_many_, 3},
+    {"_cpp4rtest_env_assign_many_", (DL_FUNC) &_cpp4rtest_env_assign_many_, 2},
     {"_cpp4rtest_my_stop_n1_", (DL_FUNC) &_cpp4rtest_my_stop_n1_, 1},
     {"_cpp4rtest_my_stop_n2_", (DL_FUNC) &_cpp4rtest_my_stop_n2_, 2},
     {"_cpp4rtest_my_warning_n1_", (DL_FUNC) &_cpp4rtest_my_warning_n1_, 1},
@@ -846,14 +1512,41 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_my_message_n2_", (DL_FUNC) &_cpp4rtest_my_message_n2_, 2},
     {"_cpp4rtest_nullable_extptr_1", (DL_FUNC) &_cpp4rtest_nullable_extptr_1, 0},
     {"_cpp4rtest_nullable_extptr_2", (DL_FUNC) &_cpp4rtest_nullable_extptr_2, 0},
+    {"_cpp4rtest_make_nodes_", (DL_FUNC) &_cpp4rtest_make_nodes_, 2},
+    {"_cpp4rtest_sum_pooled_nodes_", (DL_FUNC) &_cpp4rtest_sum_pooled_nodes_, 1},
+    {"_cpp4rtest_reset_pooled_node_", (DL_FUNC) &_cpp4rtest_reset_pooled_node_, 1},
+    {"_cpp4rtest_linear_model_", (DL_FUNC) &_cpp4rtest_linear_model_, 2},
+    {"_cpp4rtest_linear_model_info_", (DL_FUNC) &_cpp4rtest_linear_model_info_, 1},
     {"_cpp4rtest_remove_altrep", (DL_FUNC) &_cpp4rtest_remove_altrep, 1},
     {"_cpp4rtest_upper_bound", (DL_FUNC) &_cpp4rtest_upper_bound, 2},
     {"_cpp4rtest_findInterval2", (DL_FUNC) &_cpp4rtest_findInterval2, 2},
     {"_cpp4rtest_findInterval2_5", (DL_FUNC) &_cpp4rtest_findInterval2_5, 2},
     {"_cpp4rtest_findInterval3", (DL_FUNC) &_cpp4rtest_findInterval3, 2},
+    {"_cpp4rtest_findInterval4", (DL_FUNC) &_cpp4rtest_findInterval4, 5},
+    {"_cpp4rtest_call_repeatedly_", (DL_FUNC) &_cpp4rtest_call_repeatedly_, 3},
+    {"_cpp4rtest_call_vector_repeatedly_", (DL_FUNC) &_cpp4rtest_call_vector_repeatedly_, 3},
+    {"_cpp4rtest_map_batch_", (DL_FUNC) &_cpp4rtest_map_batch_, 3},
+    {"_cpp4rtest_map_batch_strings_", (DL_FUNC) &_cpp4rtest_map_batch_strings_, 3},
+    {"_cpp4rtest_group_summary_", (DL_FUNC) &_cpp4rtest_group_summary_, 4},
+    {"_cpp4rtest_group_first_last_", (DL_FUNC) &_cpp4rtest_group_first_last_, 4},
+    {"_cpp4rtest_group_ids_", (DL_FUNC) &_cpp4rtest_group_ids_, 2},
     {"_cpp4rtest_grow_", (DL_FUNC) &_cpp4rtest_grow_, 1},
     {"_cpp4rtest_grow_cplx_", (DL_FUNC) &_cpp4rtest_grow_cplx_, 1},
     {"_cpp4rtest_insert_", (DL_FUNC) &_cpp4rtest_insert_, 1},
+    {"_cpp4rtest_join_", (DL_FUNC) &_cpp4rtest_join_, 4},
+    {"_cpp4rtest_join_rows_", (DL_FUNC) &_cpp4rtest_join_rows_, 4},
+    {"_cpp4rtest_matmul_", (DL_FUNC) &_cpp4rtest_matmul_, 4},
+    {"_cpp4rtest_matmul_block_", (DL_FUNC) &_cpp4rtest_matmul_block_, 3},
+    {"_cpp4rtest_crossprod_", (DL_FUNC) &_cpp4rtest_crossprod_, 2},
+    {"_cpp4rtest_matvec_", (DL_FUNC) &_cpp4rtest_matvec_, 3},
+    {"_cpp4rtest_chol_", (DL_FUNC) &_cpp4rtest_chol_, 1},
+    {"_cpp4rtest_chol_solve_", (DL_FUNC) &_cpp4rtest_chol_solve_, 2},
+    {"_cpp4rtest_lu_solve_", (DL_FUNC) &_cpp4rtest_lu_solve_, 3},
+    {"_cpp4rtest_qr_", (DL_FUNC) &_cpp4rtest_qr_, 1},
+    {"_cpp4rtest_ols_naive_", (DL_FUNC) &_cpp4rtest_ols_naive_, 2},
+    {"_cpp4rtest_ols_blas_", (DL_FUNC) &_cpp4rtest_ols_blas_, 2},
+    {"_cpp4rtest_invert_gauss_jordan_", (DL_FUNC) &_cpp4rtest_invert_gauss_jordan_, 1},
+    {"_cpp4rtest_invert_lapack_", (DL_FUNC) &_cpp4rtest_invert_lapack_, 1},
     {"_cpp4rtest_list_of_doubles_", (DL_FUNC) &_cpp4rtest_list_of_doubles_, 0},
     {"_cpp4rtest_list_of_integers_", (DL_FUNC) &_cpp4rtest_list_of_integers_, 0},
     {"_cpp4rtest_list_of_strings_", (DL_FUNC) &_cpp4rtest_list_of_strings_, 0},
@@ -870,10 +1563,19 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_gibbs_cpp_", (DL_FUNC) &_cpp4rtest_gibbs_cpp_, 2},
     {"_cpp4rtest_gibbs_cpp2_", (DL_FUNC) &_cpp4rtest_gibbs_cpp2_, 2},
     {"_cpp4rtest_row_sums_", (DL_FUNC) &_cpp4rtest_row_sums_, 1},
+    {"_cpp4rtest_row_sums_tiled_", (DL_FUNC) &_cpp4rtest_row_sums_tiled_, 2},
+    {"_cpp4rtest_transpose_dbl_", (DL_FUNC) &_cpp4rtest_transpose_dbl_, 1},
+    {"_cpp4rtest_transpose_chr_", (DL_FUNC) &_cpp4rtest_transpose_chr_, 1},
+    {"_cpp4rtest_int_matrix_corners_", (DL_FUNC) &_cpp4rtest_int_matrix_corners_, 1},
+    {"_cpp4rtest_int_matrix_last_sums_", (DL_FUNC) &_cpp4rtest_int_matrix_last_sums_, 1},
+    {"_cpp4rtest_block_transpose_", (DL_FUNC) &_cpp4rtest_block_transpose_, 5},
+    {"_cpp4rtest_block_inner_sum_", (DL_FUNC) &_cpp4rtest_block_inner_sum_, 5},
     {"_cpp4rtest_mat_mat_copy_dimnames_", (DL_FUNC) &_cpp4rtest_mat_mat_copy_dimnames_, 1},
     {"_cpp4rtest_mat_sexp_copy_dimnames_", (DL_FUNC) &_cpp4rtest_mat_sexp_copy_dimnames_, 1},
     {"_cpp4rtest_mat_mat_create_dimnames_", (DL_FUNC) &_cpp4rtest_mat_mat_create_dimnames_, 0},
     {"_cpp4rtest_col_sums_", (DL_FUNC) &_cpp4rtest_col_sums_, 1},
+    {"_cpp4rtest_col_sums_coercing_", (DL_FUNC) &_cpp4rtest_col_sums_coercing_, 1},
+    {"_cpp4rtest_trace_coercing_", (DL_FUNC) &_cpp4rtest_trace_coercing_, 1},
     {"_cpp4rtest_matrix_add_", (DL_FUNC) &_cpp4rtest_matrix_add_, 2},
     {"_cpp4rtest_matrix_add_coerce_test_", (DL_FUNC) &_cpp4rtest_matrix_add_coerce_test_, 2},
     {"_cpp4rtest_matrix_mixed_add_", (DL_FUNC) &_cpp4rtest_matrix_mixed_add_, 2},
@@ -888,13 +1590,42 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_protect_many_", (DL_FUNC) &_cpp4rtest_protect_many_, 1},
     {"_cpp4rtest_protect_many_sexp_", (DL_FUNC) &_cpp4rtest_protect_many_sexp_, 1},
     {"_cpp4rtest_protect_many_preserve_", (DL_FUNC) &_cpp4rtest_protect_many_preserve_, 1},
+    {"_cpp4rtest_raw_stream_write_", (DL_FUNC) &_cpp4rtest_raw_stream_write_, 3},
+    {"_cpp4rtest_raw_stream_sum_", (DL_FUNC) &_cpp4rtest_raw_stream_sum_, 3},
     {"_cpp4rtest_release_", (DL_FUNC) &_cpp4rtest_release_, 1},
+    {"_cpp4rtest_roll_sum_", (DL_FUNC) &_cpp4rtest_roll_sum_, 5},
+    {"_cpp4rtest_roll_mean_", (DL_FUNC) &_cpp4rtest_roll_mean_, 5},
+    {"_cpp4rtest_roll_var_", (DL_FUNC) &_cpp4rtest_roll_var_, 5},
+    {"_cpp4rtest_roll_min_", (DL_FUNC) &_cpp4rtest_roll_min_, 5},
+    {"_cpp4rtest_roll_max_", (DL_FUNC) &_cpp4rtest_roll_max_, 5},
+    {"_cpp4rtest_roll_median_", (DL_FUNC) &_cpp4rtest_roll_median_, 5},
     {"_cpp4rtest_safe_", (DL_FUNC) &_cpp4rtest_safe_, 1},
+    {"_cpp4rtest_serialize_raw_", (DL_FUNC) &_cpp4rtest_serialize_raw_, 2},
+    {"_cpp4rtest_unserialize_raw_", (DL_FUNC) &_cpp4rtest_unserialize_raw_, 1},
+    {"_cpp4rtest_serialize_file_", (DL_FUNC) &_cpp4rtest_serialize_file_, 3},
+    {"_cpp4rtest_unserialize_file_", (DL_FUNC) &_cpp4rtest_unserialize_file_, 1},
+    {"_cpp4rtest_serialize_callback_", (DL_FUNC) &_cpp4rtest_serialize_callback_, 2},
     {"_cpp4rtest_sexp_list_init_", (DL_FUNC) &_cpp4rtest_sexp_list_init_, 0},
     {"_cpp4rtest_sexp_scalar_list_init_", (DL_FUNC) &_cpp4rtest_sexp_scalar_list_init_, 0},
+    {"_cpp4rtest_order_dbl_", (DL_FUNC) &_cpp4rtest_order_dbl_, 3},
+    {"_cpp4rtest_order_int_", (DL_FUNC) &_cpp4rtest_order_int_, 3},
+    {"_cpp4rtest_order_lgl_", (DL_FUNC) &_cpp4rtest_order_lgl_, 3},
+    {"_cpp4rtest_order_chr_", (DL_FUNC) &_cpp4rtest_order_chr_, 4},
+    {"_cpp4rtest_sort_dbl_", (DL_FUNC) &_cpp4rtest_sort_dbl_, 2},
+    {"_cpp4rtest_sort_int_", (DL_FUNC) &_cpp4rtest_sort_int_, 2},
+    {"_cpp4rtest_sort_chr_", (DL_FUNC) &_cpp4rtest_sort_chr_, 2},
     {"_cpp4rtest_grow_strings_", (DL_FUNC) &_cpp4rtest_grow_strings_, 2},
     {"_cpp4rtest_grow_strings_manual_", (DL_FUNC) &_cpp4rtest_grow_strings_manual_, 2},
     {"_cpp4rtest_assign_", (DL_FUNC) &_cpp4rtest_assign_, 2},
+    {"_cpp4rtest_subset_dbl_", (DL_FUNC) &_cpp4rtest_subset_dbl_, 2},
+    {"_cpp4rtest_subset_int_", (DL_FUNC) &_cpp4rtest_subset_int_, 2},
+    {"_cpp4rtest_subset_chr_", (DL_FUNC) &_cpp4rtest_subset_chr_, 2},
+    {"_cpp4rtest_subset_mask_dbl_", (DL_FUNC) &_cpp4rtest_subset_mask_dbl_, 2},
+    {"_cpp4rtest_subset_mask_lgl_", (DL_FUNC) &_cpp4rtest_subset_mask_lgl_, 2},
+    {"_cpp4rtest_subset_mask_cplx_", (DL_FUNC) &_cpp4rtest_subset_mask_cplx_, 2},
+    {"_cpp4rtest_subset_mask_raw_", (DL_FUNC) &_cpp4rtest_subset_mask_raw_, 2},
+    {"_cpp4rtest_assign_at_dbl_", (DL_FUNC) &_cpp4rtest_assign_at_dbl_, 3},
+    {"_cpp4rtest_assign_at_chr_", (DL_FUNC) &_cpp4rtest_assign_at_chr_, 3},
     {"_cpp4rtest_sum_dbl_for_", (DL_FUNC) &_cpp4rtest_sum_dbl_for_, 1},
     {"_cpp4rtest_sum_dbl_sexp_for_", (DL_FUNC) &_cpp4rtest_sum_dbl_sexp_for_, 1},
     {"_cpp4rtest_sum_dbl_sexp_writable_for_", (DL_FUNC) &_cpp4rtest_sum_dbl_sexp_writable_for_, 1},
@@ -930,6 +1661,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_reverse_vector_", (DL_FUNC) &_cpp4rtest_reverse_vector_, 1},
     {"_cpp4rtest_iterator_at_", (DL_FUNC) &_cpp4rtest_iterator_at_, 2},
     {"_cpp4rtest_iterator_distance_", (DL_FUNC) &_cpp4rtest_iterator_distance_, 1},
+    {"_cpp4rtest_iterator_sort_strings_", (DL_FUNC) &_cpp4rtest_iterator_sort_strings_, 1},
+    {"_cpp4rtest_iterator_sort_logicals_", (DL_FUNC) &_cpp4rtest_iterator_sort_logicals_, 1},
+    {"_cpp4rtest_iterator_sort_complexes_", (DL_FUNC) &_cpp4rtest_iterator_sort_complexes_, 1},
+    {"_cpp4rtest_iterator_nth_string_", (DL_FUNC) &_cpp4rtest_iterator_nth_string_, 2},
+    {"_cpp4rtest_iterator_reverse_list_", (DL_FUNC) &_cpp4rtest_iterator_reverse_list_, 1},
+    {"_cpp4rtest_iterator_string_at_", (DL_FUNC) &_cpp4rtest_iterator_string_at_, 2},
     {"_cpp4rtest_raw_copy_", (DL_FUNC) &_cpp4rtest_raw_copy_, 1},
     {"_cpp4rtest_raw_xor_", (DL_FUNC) &_cpp4rtest_raw_xor_, 2},
     {"_cpp4rtest_push_and_truncate_", (DL_FUNC) &_cpp4rtest_push_and_truncate_, 1},
@@ -938,11 +1675,18 @@ static const R_CallMethodDef CallEntries[] = {
     {"_cpp4rtest_weak_ref_typeof_", (DL_FUNC) &_cpp4rtest_weak_ref_typeof_, 2},
     {"_cpp4rtest_weak_ref_nil_not_alive_", (DL_FUNC) &_cpp4rtest_weak_ref_nil_not_alive_, 0},
     {"_cpp4rtest_weak_ref_rejects_vec_", (DL_FUNC) &_cpp4rtest_weak_ref_rejects_vec_, 0},
+    {"_cpp4rtest_memo_median_", (DL_FUNC) &_cpp4rtest_memo_median_, 1},
+    {"_cpp4rtest_memo_stats_", (DL_FUNC) &_cpp4rtest_memo_stats_, 1},
     {NULL, NULL, 0}
 };
 }
+
+void init_arrow_vectors(DllInfo* dll);
+void init_linear_model(DllInfo* dll);
 extern "C" attribute_visible void R_init_cpp4rtest(DllInfo* dll){
   R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
   R_useDynamicSymbols(dll, FALSE);
+  init_arrow_vectors(dll);
+  init_linear_model(dll);
   R_forceSymbols(dll, TRUE);
 }
@@ -15,3 +15,130 @@
 
   return out;
 }
+
+struct price_col : cpp4r::column_spec<double> {
+  static const char* name() { return "price"; }
+};
+struct quantity_col : cpp4r::column_spec<int> {
+  static const char* name() { return "quantity"; }
+};
+struct item_col : cpp4r::column_spec<cpp4r::r_string> {
+  static const char* name() { return "item"; }
+};
+
+using orders_df = cpp4r::data_frame_of<item_col, price_col, quantity_col>;
+
+/* roxygen
+@title Total of a Typed Data Frame on 'C++' Side
+@description Test suite
+@param x data frame with columns `item` (character), `price` (double) and
+  `quantity` (integer)
+@export
+*/
+[[cpp4r::register]] double df_of_total_(SEXP x) {
+  orders_df df(x);
+  const double* price = df.column<1>().data_ptr();
+  const cpp4r::integers& quantity = df.column<2>();
+
+  double total = 0.;
+  for (R_xlen_t i = 0; i < df.nrow(); ++i) {
+    total += price[i] * quantity[i];
+  }
+  return total;
+}
+
+/* roxygen
+@title Describe the Rows of a Typed Data Frame on 'C++' Side
+@description Test suite
+@param x data frame with columns `item` (character), `price` (double) and
+  `quantity` (integer)
+@export
+*/
+[[cpp4r::register]] cpp4r::strings df_of_rows_(SEXP x) {
+  orders_df df(x);
+  cpp4r::writable::strings out(df.nrow());
+
+  R_xlen_t i = 0;
+  for (auto row : df.rows()) {
+    std::string item = CHAR(std::get<0>(row));
+    out[i++] = item + " x" + std::to_string(std::get<2>(row));
+  }
+  return out;
+}
+
+/* roxygen
+@title Total the Rows of a Typed Data Frame on 'C++' Side
+@description Test suite
+@param x data frame with columns `item` (character), `price` (double) and
+  `quantity` (integer)
+@param item only count rows of this item
+@export
+*/
+[[cpp4r::register]] double df_of_rows_total_(SEXP x, std::string item) {
+  orders_df df(x);
+  SEXP wanted = Rf_mkCharCE(item.c_str(), CE_UTF8);
+
+  double total = 0.;
+#if CPP4R_HAS_CXX17
+  for (auto [name, price, quantity] : df.rows()) {
+    if (name == wanted) {
+      total += price * quantity;
+    }
+  }
+#else
+  for (auto row : df.rows()) {
+    if (std::get<0>(row) == wanted) {
+      total += std::get<1>(row) * std::get<2>(row);
+    }
+  }
+#endif
+  return total;
+}
+
+/* R code to benchmark typed column access against by-name lookups
+res <- bench::press(
+  n = c(1e3, 1e6),
+  {
+    df <- data.frame(
+      item = sample(letters, n, replace = TRUE),
+      price = stats::runif(n),
+      quantity = sample.int(10L, n, replace = TRUE)
+    )
+    bench::mark(
+      sum(df$price * df$quantity),
+      df_of_total_(df)
+    )
+  }
+)
+*/
+
+/* roxygen
+@title Build a Data Frame Row by Row on 'C++' Side
+@description Test suite
+@param n number of rows
+@param reserve whether to reserve the `n` rows up front
+@export
+*/
+[[cpp4r::register]] SEXP df_builder_(int n, bool reserve) {
+  static const char* groups[] = {"a", "b", "c"};
+  cpp4r::data_frame_builder<int, double, cpp4r::r_bool, cpp4r::r_string> out(
+      {"id", "value", "even", "group"}, reserve ? n : 0);
+
+  for (int i = 0; i < n; ++i) {
+    out.push_back(i + 1, i / 2., i % 2 == 0, groups[i % 3]);
+  }
+  return out.finish();
+}
+
+/* R code to benchmark row appends against growing R vectors
+res <- bench::press(
+  n = c(1e3, 1e6),
+  {
+    bench::mark(
+      df_builder_(n, FALSE),
+      df_builder_(n, TRUE),
+      check = FALSE
+    )
+  }
+)
+*/
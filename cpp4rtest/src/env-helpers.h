@@ -140,3 +140,94 @@ using namespace cpp4r;
   }
   return static_cast<int>(std::distance(x.begin(), it)) + 1;  // 1-indexed
 }
+
+/* roxygen
+@title Read a Variable Repeatedly from an Environment on 'C++' Side
+@description Test suite
+@param env R environment containing a number `x`
+@param n number of reads
+@param cached whether to look `x` up through a cached `symbol`
+@export
+*/
+[[cpp4r::register]] double env_sum_x_(environment env, int n, bool cached) {
+  static const cpp4r::symbol x("x");
+  double total = 0.;
+  for (int i = 0; i < n; ++i) {
+    total += cached ? as_cpp<double>(env[x]) : as_cpp<double>(env["x"]);
+  }
+  return total;
+}
+
+/* roxygen
+@title Call a Base Function with a Symbol-Named Argument on 'C++' Side
+@description Test suite
+@param x numeric vector
+@export
+*/
+[[cpp4r::register]] double symbol_call_(doubles x) {
+  static const cpp4r::symbol sum("sum"), na_rm("na.rm");
+  function base_sum = package("base")[sum];
+  return as_cpp<double>(base_sum(x, named_arg(na_rm, true)));
+}
+
+/* R code to benchmark cached symbols against installing the name on each lookup
+e <- new.env()
+e$x <- 1
+bench::mark(
+  env_sum_x_(e, 1e5, FALSE),
+  env_sum_x_(e, 1e5, TRUE)
+)
+*/
+
+/* roxygen
+@title Sum the Numeric Bindings of an Environment on 'C++' Side
+@description Test suite
+@param env R environment holding numbers
+@export
+*/
+[[cpp4r::register]] double env_bindings_sum_(environment env) {
+  double total = 0.;
+  for (auto b : env.bindings()) {
+    total += as_cpp<double>(b.value);
+  }
+  return total;
+}
+
+/* roxygen
+@title Get Several Bindings of an Environment on 'C++' Side
+@description Test suite
+@param env R environment
+@param names character vector of names
+@param missing whether to return `NULL` for missing names instead of erroring
+@export
+*/
+[[cpp4r::register]] SEXP env_get_many_(environment env, strings names, bool missing) {
+  return missing ? env.get_many(names, R_NilValue) : env.get_many(names);
+}
+
+/* roxygen
+@title Assign Several Bindings in an Environment on 'C++' Side
+@description Test suite
+@param env R environment
+@param values named list of values to assign
+@export
+*/
+[[cpp4r::register]] void env_assign_many_(environment env, list values) {
+  env.assign_many(values);
+}
+
+/* R code to benchmark bulk access against R-level ls() and mget()
+e <- new.env(hash = TRUE)
+values <- as.list(as.double(seq_len(1e5)))
+names(values) <- paste0("k", seq_len(1e5))
+env_assign_many_(e, values)
+bench::mark(
+  sum(unlist(mget(ls(e, sorted = FALSE), envir = e))),
+  env_bindings_sum_(e)
+)
+bench::mark(
+  mget(names(values), envir = e),
+  env_get_many_(e, names(values), FALSE),
+  check = FALSE
+)
+*/
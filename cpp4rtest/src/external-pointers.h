@@ -17,3 +17,133 @@
 [[cpp4r::register]] cpp4r::external_pointer<int> nullable_extptr_2() {
   return cpp4r::external_pointer<int>(R_NilValue);
 }
+
+struct tree_node {
+  double value;
+  int left;
+  int right;
+  tree_node(double value_, int left_, int right_)
+      : value(value_), left(left_), right(right_) {}
+};
+
+/* roxygen
+@title Make Many External Pointers on 'C++' Side
+@description Test suite
+@param n number of handles to make
+@param pooled whether to allocate them from an `object_pool`
+@export
+*/
+[[cpp4r::register]] cpp4r::list make_nodes_(int n, bool pooled) {
+  static cpp4r::object_pool<tree_node> pool;
+  cpp4r::writable::list out(n);
+  for (int i = 0; i < n; ++i) {
+    if (pooled) {
+      out[i] = pool.make(static_cast<double>(i), i - 1, i + 1);
+    } else {
+      out[i] = cpp4r::external_pointer<tree_node>(
+          new tree_node(static_cast<double>(i), i - 1, i + 1));
+    }
+  }
+  return out;
+}
+
+/* roxygen
+@title Sum the Values of Pooled Nodes on 'C++' Side
+@description Test suite
+@param nodes list of handles made by `make_nodes_(n, TRUE)`
+@export
+*/
+[[cpp4r::register]] double sum_pooled_nodes_(cpp4r::list nodes) {
+  double total = 0.;
+  for (SEXP node : nodes) {
+    cpp4r::pooled_pointer<tree_node> p(node);
+    if (p) {
+      total += p->value;
+    }
+  }
+  return total;
+}
+
+/* roxygen
+@title Destroy a Pooled Node Early on 'C++' Side
+@description Test suite
+@param node handle made by `make_nodes_(n, TRUE)`
+@export
+*/
+[[cpp4r::register]] void reset_pooled_node_(SEXP node) {
+  cpp4r::pooled_pointer<tree_node>(node).reset();
+}
+
+/* R code to benchmark allocation and collection of pooled and plain external pointers
+bench::mark(
+  external_pointer = {
+    x <- make_nodes_(1e6, FALSE)
+    rm(x)
+    gc()
+  },
+  object_pool = {
+    x <- make_nodes_(1e6, TRUE)
+    rm(x)
+    gc()
+  },
+  iterations = 5,
+  check = FALSE
+)
+*/
+
+struct linear_model {
+  std::string label;
+  std::vector<double> weights;
+};
+
+inline void serialize(const linear_model& x, cpp4r::raw_writer& out) {
+  out.write(x.label);
+  out.write(x.weights);
+}
+
+inline void deserialize(linear_model& x, cpp4r::raw_reader& in) {
+  in.read(x.label);
+  in.read(x.weights);
+}
+
+[[cpp4r::init]] void init_linear_model(DllInfo* dll) {
+  cpp4r::serializable_pointer<linear_model>::init(dll, "cpp4rtest", "linear_model");
+}
+
+/* roxygen
+@title Make a Serializable External Pointer on 'C++' Side
+@description Test suite
+@param label name of the model
+@param weights numeric weights
+@export
+*/
+[[cpp4r::register]] SEXP linear_model_(std::string label, cpp4r::doubles weights) {
+  return cpp4r::serializable_pointer<linear_model>(
+      new linear_model{label, std::vector<double>(weights.begin(), weights.end())});
+}
+
+/* roxygen
+@title Describe a Serializable External Pointer on 'C++' Side
+@description Test suite
+@param model handle made by `linear_model_()`
+@export
+*/
+[[cpp4r::register]] cpp4r::list linear_model_info_(SEXP model) {
+  cpp4r::serializable_pointer<linear_model> p(model);
+  const bool materialized = p.materialized();
+  double total = 0.;
+  for (double w : p->weights) {
+    total += w;
+  }
+  using namespace cpp4r::literals;
+  return cpp4r::writable::list({"label"_nm = p->label, "sum"_nm = total,
+                                "materialized"_nm = materialized});
+}
+
+/* R code to benchmark the round trip of a serializable external pointer
+m <- linear_model_("big", runif(1e7))
+bench::mark(
+  unserialize(serialize(m, NULL)),
+  linear_model_info_(unserialize(serialize(m, NULL)))
+)
+*/
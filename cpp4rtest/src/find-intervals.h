@@ -87,6 +87,26 @@
   return out;
 }
 
+/* roxygen
+@title Find Intervals with the Batched Kernel on 'C++' Side
+@description Test suite
+@param x vector of values to find intervals for
+@param breaks vector of break points
+@param rightmost_closed as in `findInterval()`
+@param all_inside as in `findInterval()`
+@param left_open as in `findInterval()`
+@export
+*/
+[[cpp4r::register]] integers findInterval4(doubles x, doubles breaks,
+                                           bool rightmost_closed, bool all_inside,
+                                           bool left_open) {
+  cpp4r::find_interval_options options;
+  options.rightmost_closed = rightmost_closed;
+  options.all_inside = all_inside;
+  options.left_open = left_open;
+  return cpp4r::find_interval(x, breaks, options);
+}
+
 /* R code to benchmark these implementations
 res <- bench::press(
   n1 = 10^seq(1, 3),
@@ -99,6 +119,7 @@ res <- bench::press(
       findInterval2(x, y),
       findInterval2_5(x, y),
       findInterval3(x, y),
+      findInterval4(x, y, FALSE, FALSE, FALSE),
     )
   }
 )
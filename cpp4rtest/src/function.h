@@ -0,0 +1,93 @@
+/* roxygen
+@title Evaluate an R Function Repeatedly on 'C++' Side
+@description Test suite
+@param fn R function of one number returning a number
+@param n number of calls, with the arguments `1, 2, ..., n`
+@param prepared whether to use a `prepared_call` instead of `function::operator()`
+@export
+*/
+[[cpp4r::register]] double call_repeatedly_(SEXP fn, int n, bool prepared) {
+  cpp4r::function f(fn);
+  double total = 0.;
+  if (prepared) {
+    cpp4r::prepared_call call(f, 1);
+    for (int i = 1; i <= n; ++i) {
+      total += cpp4r::as_cpp<double>(call(static_cast<double>(i)));
+    }
+  } else {
+    for (int i = 1; i <= n; ++i) {
+      total += cpp4r::as_cpp<double>(f(static_cast<double>(i)));
+    }
+  }
+  return total;
+}
+
+/* roxygen
+@title Evaluate an R Function of a Vector Repeatedly on 'C++' Side
+@description Test suite
+@param fn R function of a double vector and `scale`, returning a number
+@param x starting point, shifted by 1 after every call
+@param n number of calls
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles call_vector_repeatedly_(SEXP fn, cpp4r::doubles x,
+                                                           int n) {
+  cpp4r::prepared_call call(cpp4r::function(fn), {"", "scale"});
+  std::vector<double> point(x.begin(), x.end());
+  cpp4r::writable::doubles out(n);
+  for (int i = 0; i < n; ++i) {
+    out[i] = cpp4r::as_cpp<double>(call(point, 2.));
+    for (double& value : point) value += 1.;
+  }
+  return out;
+}
+
+/* roxygen
+@title Map a Vectorized R Function over Batches on 'C++' Side
+@description Test suite
+@param fn vectorized R function
+@param x atomic vector or list of inputs
+@param batch_size number of inputs per call
+@export
+*/
+[[cpp4r::register]] SEXP map_batch_(SEXP fn, SEXP x, int batch_size) {
+  return cpp4r::function(fn).map_batch(x, batch_size);
+}
+
+/* roxygen
+@title Map a Vectorized R Function over Batches of Strings on 'C++' Side
+@description Test suite
+@param fn vectorized R function of a character vector
+@param x character vector of inputs, passed as a `std::vector<std::string>`
+@param batch_size number of inputs per call
+@export
+*/
+[[cpp4r::register]] SEXP map_batch_strings_(SEXP fn, cpp4r::strings x, int batch_size) {
+  std::vector<std::string> inputs(x.begin(), x.end());
+  return cpp4r::function(fn).map_batch(inputs, batch_size);
+}
+
+/* R code to benchmark prepared calls against building the call every time
+res <- bench::press(
+  n = c(1e3, 1e5),
+  {
+    f <- function(x) x * x
+    bench::mark(
+      call_repeatedly_(f, n, FALSE),
+      call_repeatedly_(f, n, TRUE)
+    )
+  }
+)
+*/
+
+/* R code to benchmark batched calls against one call per element
+res <- bench::press(
+  batch_size = c(1, 100, 1e4),
+  {
+    x <- stats::runif(1e5)
+    bench::mark(
+      map_batch_(sqrt, x, batch_size)
+    )
+  }
+)
+*/
@@ -0,0 +1,66 @@
+/* roxygen
+@title Summarise a Numeric Column by Group on 'C++' Side
+@description Test suite
+@param x data frame
+@param key name of the grouping column (integer, factor, logical or character)
+@param value name of a numeric column
+@param parallel whether large inputs may be aggregated in parallel
+@export
+*/
+[[cpp4r::register]] SEXP group_summary_(SEXP x, std::string key, std::string value,
+                                        bool parallel) {
+  return cpp4r::group_by(cpp4r::data_frame(x), key)
+      .summarise({cpp4r::agg::count(), cpp4r::agg::sum(value), cpp4r::agg::mean(value),
+                  cpp4r::agg::min(value), cpp4r::agg::max(value)},
+                 parallel);
+}
+
+/* roxygen
+@title First and Last Values by Two Keys on 'C++' Side
+@description Test suite
+@param x data frame
+@param key1,key2 names of the grouping columns
+@param value name of any atomic column
+@export
+*/
+[[cpp4r::register]] SEXP group_first_last_(SEXP x, std::string key1, std::string key2,
+                                           std::string value) {
+  return cpp4r::group_by(cpp4r::data_frame(x), key1, key2)
+      .summarise({cpp4r::agg::first(value, "first"), cpp4r::agg::last(value, "last")});
+}
+
+/* roxygen
+@title Group Ids of the Rows on 'C++' Side
+@description Test suite
+@param x data frame
+@param key name of the grouping column
+@export
+*/
+[[cpp4r::register]] cpp4r::integers group_ids_(SEXP x, std::string key) {
+  cpp4r::grouping g = cpp4r::group_by(cpp4r::data_frame(x), key);
+  cpp4r::writable::integers out(g.nrow());
+  for (R_xlen_t i = 0; i < g.nrow(); ++i) {
+    out[i] = g.ids()[i] + 1;
+  }
+  return out;
+}
+
+/* R code to benchmark grouped sums against base R
+res <- bench::press(
+  n = c(1e4, 1e6),
+  groups = c(10, 1e4),
+  {
+    df <- data.frame(
+      g = sample(sprintf("g%05d", seq_len(groups)), n, replace = TRUE),
+      x = stats::runif(n)
+    )
+    bench::mark(
+      rowsum(df$x, df$g, reorder = FALSE)[, 1],
+      tapply(df$x, df$g, sum),
+      group_summary_(df, "g", "x", FALSE)$x_sum,
+      group_summary_(df, "g", "x", TRUE)$x_sum,
+      check = FALSE
+    )
+  }
+)
+*/
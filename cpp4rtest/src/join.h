@@ -0,0 +1,64 @@
+inline cpp4r::join_type join_type_from(const std::string& type) {
+  if (type == "inner") return cpp4r::join_type::inner;
+  if (type == "left") return cpp4r::join_type::left;
+  if (type == "semi") return cpp4r::join_type::semi;
+  if (type == "anti") return cpp4r::join_type::anti;
+  cpp4r::stop("Unknown join type '%s'", type.c_str());
+}
+
+inline std::vector<std::string> join_keys(cpp4r::strings by) {
+  return std::vector<std::string>(by.begin(), by.end());
+}
+
+/* roxygen
+@title Join Two Data Frames on 'C++' Side
+@description Test suite
+@param x,y data frames
+@param by names of the key columns
+@param type one of "inner", "left", "semi" or "anti"
+@export
+*/
+[[cpp4r::register]] SEXP join_(SEXP x, SEXP y, cpp4r::strings by, std::string type) {
+  return cpp4r::join(cpp4r::data_frame(x), cpp4r::data_frame(y), join_keys(by),
+                     join_type_from(type));
+}
+
+/* roxygen
+@title Matching Rows of Two Data Frames on 'C++' Side
+@description Test suite
+@param x,y data frames
+@param by names of the key columns
+@param type one of "inner", "left", "semi" or "anti"
+@return A list with the 1-based rows of `x` and `y` (`NA` for no match).
+@export
+*/
+[[cpp4r::register]] cpp4r::list join_rows_(SEXP x, SEXP y, cpp4r::strings by,
+                                           std::string type) {
+  cpp4r::join_indices rows = cpp4r::join_rows(cpp4r::data_frame(x), cpp4r::data_frame(y),
+                                              join_keys(by), join_type_from(type));
+  cpp4r::writable::doubles out_x(static_cast<R_xlen_t>(rows.x.size()));
+  cpp4r::writable::doubles out_y(static_cast<R_xlen_t>(rows.y.size()));
+  for (R_xlen_t i = 0; i < out_x.size(); ++i) {
+    out_x[i] = rows.x[i] + 1.;
+  }
+  for (R_xlen_t i = 0; i < out_y.size(); ++i) {
+    out_y[i] = rows.y[i] < 0 ? NA_REAL : rows.y[i] + 1.;
+  }
+  using namespace cpp4r::literals;
+  return cpp4r::writable::list({"x"_nm = out_x, "y"_nm = out_y});
+}
+
+/* R code to benchmark joins against base R
+res <- bench::press(
+  n = c(1e4, 1e6),
+  {
+    x <- data.frame(id = sample.int(n), v = stats::runif(n))
+    y <- data.frame(id = sample.int(n, n / 10), w = stats::runif(n / 10))
+    bench::mark(
+      merge(x, y, by = "id", sort = FALSE),
+      join_(x, y, "id", "inner"),
+      check = FALSE
+    )
+  }
+)
+*/
@@ -0,0 +1,263 @@
+#include <cpp4r/linalg.hpp>
+
+/* roxygen
+@title Matrix Product with BLAS on 'C++' Side
+@description Test suite
+@param a matrix of doubles
+@param b matrix of doubles
+@param trans_a whether to transpose `a`
+@param trans_b whether to transpose `b`
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> matmul_(doubles_matrix<> a, doubles_matrix<> b,
+                                             bool trans_a, bool trans_b) {
+  return cpp4r::linalg::gemm(a, b, trans_a, trans_b);
+}
+
+/* roxygen
+@title Matrix Product of Blocks with BLAS on 'C++' Side
+@description Test suite
+@param a matrix of doubles
+@param b matrix of doubles
+@param k number of leading columns of `a` (and leading rows of `b`) to multiply
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> matmul_block_(doubles_matrix<> a, doubles_matrix<> b,
+                                                   int k) {
+  // `a[, 1:k] %*% b[1:k, ]`, without copying either block
+  return cpp4r::linalg::gemm(a.block(0, 0, a.nrow(), k), b.block(0, 0, k, b.ncol()));
+}
+
+/* roxygen
+@title Cross Product with BLAS on 'C++' Side
+@description Test suite
+@param a matrix of doubles
+@param trans `TRUE` for `crossprod(a)`, `FALSE` for `tcrossprod(a)`
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> crossprod_(doubles_matrix<> a, bool trans) {
+  return cpp4r::linalg::syrk(a, trans);
+}
+
+/* roxygen
+@title Matrix-Vector Product with BLAS on 'C++' Side
+@description Test suite
+@param a matrix of doubles
+@param x vector of doubles
+@param trans whether to transpose `a`
+@export
+*/
+[[cpp4r::register]] doubles matvec_(doubles_matrix<> a, doubles x, bool trans) {
+  return cpp4r::linalg::gemv(a, x, trans);
+}
+
+/* roxygen
+@title Cholesky Factorization with LAPACK on 'C++' Side
+@description Test suite
+@param a symmetric positive definite matrix
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> chol_(doubles_matrix<> a) {
+  return cpp4r::linalg::potrf(a);
+}
+
+/* roxygen
+@title Solve a System with a Cholesky Factorization on 'C++' Side
+@description Test suite
+@param a symmetric positive definite matrix
+@param b right-hand side matrix
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> chol_solve_(doubles_matrix<> a, doubles_matrix<> b) {
+  return cpp4r::linalg::potrs(cpp4r::linalg::potrf(a), b);
+}
+
+/* roxygen
+@title Solve a System with an LU Factorization on 'C++' Side
+@description Test suite
+@param a square matrix
+@param b right-hand side matrix
+@param trans whether to solve `t(a) %*% x = b`
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> lu_solve_(doubles_matrix<> a, doubles_matrix<> b,
+                                               bool trans) {
+  return cpp4r::linalg::getrs(cpp4r::linalg::getrf(a), b, trans);
+}
+
+/* roxygen
+@title QR Factorization with LAPACK on 'C++' Side
+@description Test suite
+@param a matrix of doubles
+@export
+*/
+[[cpp4r::register]] list qr_(doubles_matrix<> a) {
+  cpp4r::linalg::qr f = cpp4r::linalg::geqrf(a);
+  return writable::list({"qr"_nm = f.factors, "qraux"_nm = f.tau});
+}
+
+// The OLS estimator and matrix inverse from the cpp4rols and cpp4rgaussjordan examples,
+// first as written there (triple loops and Gauss-Jordan elimination) and then on BLAS and
+// LAPACK
+
+/* roxygen
+@title OLS Estimator with Naive Loops on 'C++' Side
+@description Test suite
+@param X design matrix
+@param Y response matrix with one column
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> ols_naive_(doubles_matrix<> X, doubles_matrix<> Y) {
+  int N = X.nrow();
+  int M = X.ncol();
+
+  if (Y.nrow() != N || Y.ncol() != 1) {
+    stop("Y must have one column and as many rows as X");
+  }
+
+  // X'X and X'Y
+  writable::doubles_matrix<> A(M, M);
+  writable::doubles_matrix<> B(M, 1);
+  for (int i = 0; i < M; i++) {
+    B(i, 0) = 0.0;
+    for (int k = 0; k < N; k++) {
+      B(i, 0) += X(k, i) * Y(k, 0);
+    }
+    for (int j = 0; j < M; j++) {
+      A(i, j) = 0.0;
+      for (int k = 0; k < N; k++) {
+        A(i, j) += X(k, i) * X(k, j);
+      }
+    }
+  }
+
+  // (X'X)^-1 (X'Y) with Gauss-Jordan elimination on [X'X | X'Y]
+  for (int i = 0; i < M; i++) {
+    double a = A(i, i);
+    for (int j = 0; j < M; j++) {
+      A(i, j) /= a;
+    }
+    B(i, 0) /= a;
+
+    for (int j = 0; j < M; j++) {
+      if (i != j) {
+        a = A(j, i);
+        for (int k = 0; k < M; k++) {
+          A(j, k) -= A(i, k) * a;
+        }
+        B(j, 0) -= B(i, 0) * a;
+      }
+    }
+  }
+
+  return B;
+}
+
+/* roxygen
+@title OLS Estimator with BLAS and LAPACK on 'C++' Side
+@description Test suite
+@param X design matrix
+@param Y response matrix with one column
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> ols_blas_(doubles_matrix<> X, doubles_matrix<> Y) {
+  if (Y.nrow() != X.nrow() || Y.ncol() != 1) {
+    stop("Y must have one column and as many rows as X");
+  }
+
+  // Solve X'X b = X'Y through the Cholesky factor of X'X
+  doubles_matrix<> XtX = cpp4r::linalg::syrk(X);
+  doubles_matrix<> XtY = cpp4r::linalg::gemm(X, Y, true, false);
+  return cpp4r::linalg::potrs(cpp4r::linalg::potrf(XtX), XtY);
+}
+
+/* roxygen
+@title Matrix Inverse with Gauss-Jordan Elimination on 'C++' Side
+@description Test suite
+@param A square matrix
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> invert_gauss_jordan_(doubles_matrix<> A) {
+  int N = A.nrow();
+
+  if (A.ncol() != N) {
+    stop("A must be a square matrix");
+  }
+
+  writable::doubles_matrix<> Acopy(N, N);
+  writable::doubles_matrix<> Ainv(N, N);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      Acopy(i, j) = A(i, j);
+      Ainv(i, j) = (i == j) ? 1.0 : 0.0;
+    }
+  }
+
+  for (int i = 0; i < N; i++) {
+    double a = Acopy(i, i);
+    for (int j = 0; j < N; j++) {
+      Acopy(i, j) /= a;
+      Ainv(i, j) /= a;
+    }
+
+    for (int j = 0; j < N; j++) {
+      if (i != j) {
+        a = Acopy(j, i);
+        for (int k = 0; k < N; k++) {
+          Acopy(j, k) -= Acopy(i, k) * a;
+          Ainv(j, k) -= Ainv(i, k) * a;
+        }
+      }
+    }
+  }
+
+  return Ainv;
+}
+
+/* roxygen
+@title Matrix Inverse with LAPACK on 'C++' Side
+@description Test suite
+@param A square matrix
+@export
+*/
+[[cpp4r::register]] doubles_matrix<> invert_lapack_(doubles_matrix<> A) {
+  int N = A.nrow();
+
+  writable::doubles_matrix<> I(N, N);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      I(i, j) = (i == j) ? 1.0 : 0.0;
+    }
+  }
+
+  return cpp4r::linalg::getrs(cpp4r::linalg::getrf(A), I);
+}
+
+/* R code to benchmark the examples against BLAS and LAPACK
+res_ols <- bench::press(
+  n = c(1000, 10000, 100000),
+  p = c(10, 100),
+  {
+    X <- cbind(1, matrix(stats::rnorm(n * (p - 1)), n, p - 1))
+    Y <- X %*% stats::rnorm(p) + stats::rnorm(n)
+    bench::mark(
+      ols_naive_(X, Y),
+      ols_blas_(X, Y),
+      check = function(a, b) isTRUE(all.equal(a, b))
+    )
+  }
+)
+
+res_inv <- bench::press(
+  n = c(10, 100, 500),
+  {
+    A <- crossprod(matrix(stats::rnorm(2 * n * n), 2 * n, n))
+    bench::mark(
+      invert_gauss_jordan_(A),
+      invert_lapack_(A),
+      solve(A),
+      check = function(a, b) isTRUE(all.equal(a, b))
+    )
+  }
+)
+*/
@@ -4,24 +4,36 @@
 #include <Rmath.h>  // for Rf_rgamma, Rf_rnorm
 #include <deque>    // for std::deque
 #include <numeric>  // for std::accumulate
+#include <sstream>  // for std::ostringstream
 
 using namespace cpp4r;
 
 // Include all test function headers
 #include "add.h"
+#include "array.h"
+#include "arrow.h"
 #include "data_frame.h"
 #include "errors.h"
 #include "external-pointers.h"
 #include "find-intervals.h"
+#include "function.h"
+#include "group_by.h"
 #include "grow.h"
 #include "insert.h"
+#include "join.h"
+#include "linalg.h"
 #include "lists.h"
 #include "map.h"
 #include "matrix.h"
 #include "protect.h"
+#include "raw_streams.h"
 #include "release.h"
+#include "rolling.h"
 #include "safe.h"
+#include "serialize.h"
+#include "sort.h"
 #include "strings.h"
+#include "subset.h"
 #include "sum.h"
 #include "sum_cplx.h"
 #include "sum_int.h"
@@ -71,6 +71,152 @@
   return sums;
 }
 
+/* roxygen
+@title Row Sums over Tiles of Rows on 'C++' Side
+@description Test suite
+@param x matrix of doubles (R)
+@param tile_rows rows per tile, or 0 to size tiles automatically
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles row_sums_tiled_(cpp4r::doubles_matrix<> x,
+                                                   int tile_rows) {
+  cpp4r::writable::doubles sums(x.nrow());
+
+  for (auto tile : x.row_tiles(tile_rows)) {
+    for (int i = 0; i < tile.nrow(); ++i) {
+      const double* row = tile.row(i);
+      double sum = 0.;
+      for (int j = 0; j < tile.ncol(); ++j) {
+        sum += row[j];
+      }
+      sums[tile.first_row() + i] = sum;
+    }
+  }
+
+  return sums;
+}
+
+/* R code to benchmark row sums by_row against tiles of rows
+res <- bench::press(
+  nrow = c(1e4, 1e5),
+  ncol = c(1e2, 1e3),
+  {
+    x <- matrix(stats::runif(nrow * ncol), nrow, ncol)
+    bench::mark(
+      rowSums(x),
+      row_sums_(x),
+      row_sums_tiled_(x, 0L)
+    )
+  }
+)
+*/
+
+/* roxygen
+@title Transpose a Matrix of Doubles on 'C++' Side
+@description Test suite
+@param x matrix of doubles (R)
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles_matrix<> transpose_dbl_(cpp4r::doubles_matrix<> x) {
+  return cpp4r::transpose(x);
+}
+
+/* roxygen
+@title Transpose a Matrix of Strings on 'C++' Side
+@description Test suite
+@param x matrix of strings (R)
+@export
+*/
+[[cpp4r::register]] cpp4r::strings_matrix<> transpose_chr_(cpp4r::strings_matrix<> x) {
+  return cpp4r::transpose(x);
+}
+
+/* R code to benchmark the transpose
+res <- bench::press(
+  n = c(1e2, 1e3, 5e3),
+  {
+    x <- matrix(stats::runif(n * n), n, n)
+    bench::mark(
+      t(x),
+      transpose_dbl_(x)
+    )
+  }
+)
+*/
+
+/* roxygen
+@title Corners of an Integer Matrix on 'C++' Side
+@description Test suite
+@param x matrix of integers (R)
+@export
+*/
+[[cpp4r::register]] cpp4r::integers int_matrix_corners_(cpp4r::integers_matrix<> x) {
+  const int last_row = x.nrow() - 1;
+  const int last_col = x.ncol() - 1;
+  cpp4r::writable::integers out(
+      {x(0, 0), x(last_row, 0), x(0, last_col), x(last_row, last_col)});
+  return out;
+}
+
+/* roxygen
+@title Sums of the Last Row and Column of an Integer Matrix on 'C++' Side
+@description Test suite
+@param x matrix of integers (R)
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles int_matrix_last_sums_(cpp4r::integers_matrix<> x) {
+  cpp4r::integers_matrix<cpp4r::by_row> rows(x);
+
+  double row_sum = 0.;
+  for (int value : rows[rows.nslices() - 1]) {
+    row_sum += value;
+  }
+  double col_sum = 0.;
+  for (int value : x[x.nslices() - 1]) {
+    col_sum += value;
+  }
+
+  cpp4r::writable::doubles out({row_sum, col_sum});
+  return out;
+}
+
+/* roxygen
+@title Transpose a Block of a Matrix on 'C++' Side
+@description Test suite
+@param x matrix of doubles (R)
+@param row,col 0-based position of the top-left element of the block
+@param nrow,ncol dimensions of the block
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles_matrix<> block_transpose_(cpp4r::doubles_matrix<> x,
+                                                             int row, int col, int nrow,
+                                                             int ncol) {
+  return cpp4r::transpose(x.block(row, col, nrow, ncol));
+}
+
+/* roxygen
+@title Sum a Block of a Block of a Matrix on 'C++' Side
+@description Test suite
+@param x matrix of doubles (R)
+@param row,col 0-based position of the top-left element of the outer block
+@param nrow,ncol dimensions of the outer block
+@export
+*/
+[[cpp4r::register]] double block_inner_sum_(cpp4r::doubles_matrix<> x, int row, int col,
+                                            int nrow, int ncol) {
+  // Everything but the border of the block
+  auto outer = x.block(row, col, nrow, ncol);
+  auto inner = outer.block(1, 1, nrow - 2, ncol - 2);
+
+  double sum = 0.;
+  for (int j = 0; j < inner.ncol(); ++j) {
+    for (int i = 0; i < inner.nrow(); ++i) {
+      sum += inner(i, j);
+    }
+  }
+  return sum;
+}
+
 /* roxygen
 @title Copy Matrix with Dimnames
 @description Test suite
@@ -147,6 +293,57 @@
   return sums;
 }
 
+/* roxygen
+@title Compute Column Sums without Copying Integer Matrices
+@description Test suite
+@param x matrix of doubles, integers or logicals (R)
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles col_sums_coercing_(cpp4r::coercing_doubles_matrix x) {
+  cpp4r::writable::doubles sums(x.ncol());
+
+  for (auto block : x.column_blocks()) {
+    for (int j = 0; j < block.ncol(); ++j) {
+      const double* col = block.column(j);
+      double sum = 0.;
+      for (int i = 0; i < block.nrow(); ++i) {
+        sum += col[i];
+      }
+      sums[block.first_col() + j] = sum;
+    }
+  }
+
+  return sums;
+}
+
+/* roxygen
+@title Compute the Trace without Copying Integer Matrices
+@description Test suite
+@param x square matrix of doubles, integers or logicals (R)
+@export
+*/
+[[cpp4r::register]] double trace_coercing_(cpp4r::coercing_doubles_matrix x) {
+  double sum = 0.;
+  for (int i = 0; i < x.nrow(); ++i) {
+    sum += x(i, i);
+  }
+  return sum;
+}
+
+/* R code to benchmark column sums of an integer matrix, coerced up front or lazily
+res <- bench::press(
+  n = c(1e3, 5e3),
+  {
+    x <- matrix(sample.int(100L, n * n, replace = TRUE), n, n)
+    bench::mark(
+      colSums(x),
+      col_sums_(x),
+      col_sums_coercing_(x)
+    )
+  }
+)
+*/
+
 // Test function for automatic integer to double matrix coercion
 /* roxygen
 @title Add Two Matrices (with Coercion)
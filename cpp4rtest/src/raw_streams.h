@@ -0,0 +1,69 @@
+/* roxygen
+@title Write Bytes Through a Stream on 'C++' Side
+@description Test suite
+@param n number of bytes to write
+@param chunk number of bytes per write
+@param stringstream whether to write to a `std::ostringstream` and copy into a raw vector
+@export
+*/
+[[cpp4r::register]] cpp4r::raws raw_stream_write_(double n, int chunk,
+                                                  bool stringstream) {
+  const R_xlen_t total = static_cast<R_xlen_t>(n);
+  std::vector<char> block(static_cast<std::size_t>(chunk));
+  for (int i = 0; i < chunk; ++i) {
+    block[i] = static_cast<char>(i % 251);
+  }
+
+  auto write_all = [&](std::ostream& out) {
+    for (R_xlen_t written = 0; written < total; written += chunk) {
+      out.write(block.data(), std::min<R_xlen_t>(chunk, total - written));
+    }
+  };
+
+  if (stringstream) {
+    std::ostringstream out;
+    write_all(out);
+    const std::string bytes = out.str();
+    cpp4r::writable::raws result(static_cast<R_xlen_t>(bytes.size()));
+    std::memcpy(RAW(result), bytes.data(), bytes.size());
+    return result;
+  }
+
+  cpp4r::raw_ostreambuf buf;
+  std::ostream out(&buf);
+  write_all(out);
+  return buf.finish();
+}
+
+/* roxygen
+@title Sum Bytes Read Through a Stream on 'C++' Side
+@description Test suite
+@param x raw vector
+@param chunk number of bytes per read
+@param skip number of bytes to seek past first
+@export
+*/
+[[cpp4r::register]] double raw_stream_sum_(cpp4r::raws x, int chunk, double skip) {
+  cpp4r::raw_istreambuf buf(x);
+  std::istream in(&buf);
+  in.exceptions(std::ios_base::badbit);
+  in.seekg(static_cast<std::streamoff>(skip));
+  std::vector<char> block(static_cast<std::size_t>(chunk));
+  double total = 0.;
+  while (in.read(block.data(), chunk) || in.gcount() > 0) {
+    for (std::streamsize i = 0; i < in.gcount(); ++i) {
+      total += static_cast<unsigned char>(block[i]);
+    }
+  }
+  return total;
+}
+
+/* R code to benchmark 1 GB payloads through raw_ostreambuf against std::ostringstream
+bench::mark(
+  raw_stream_write_(1e9, 65536, TRUE),
+  raw_stream_write_(1e9, 65536, FALSE),
+  iterations = 3
+)
+x <- raw_stream_write_(1e9, 65536, FALSE)
+bench::mark(raw_stream_sum_(x, 65536, 0), iterations = 3)
+*/
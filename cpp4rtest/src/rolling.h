@@ -0,0 +1,116 @@
+inline cpp4r::rolling::options rolling_options(std::string align, bool na_rm, bool partial) {
+  cpp4r::rolling::options options;
+  if (align == "left") {
+    options.align = cpp4r::rolling::alignment::left;
+  } else if (align == "center") {
+    options.align = cpp4r::rolling::alignment::center;
+  }
+  options.na_rm = na_rm;
+  options.partial = partial;
+  return options;
+}
+
+/* roxygen
+@title Rolling Sum on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param width window width
+@param align one of "right", "center" or "left"
+@param na_rm whether to skip missing values
+@param partial whether to summarise incomplete windows at the edges
+@export
+*/
+[[cpp4r::register]] doubles roll_sum_(doubles x, int width, std::string align, bool na_rm,
+                                      bool partial) {
+  return cpp4r::rolling::sum(x, width, rolling_options(align, na_rm, partial));
+}
+
+/* roxygen
+@title Rolling Mean on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param width window width
+@param align one of "right", "center" or "left"
+@param na_rm whether to skip missing values
+@param partial whether to summarise incomplete windows at the edges
+@export
+*/
+[[cpp4r::register]] doubles roll_mean_(doubles x, int width, std::string align,
+                                       bool na_rm, bool partial) {
+  return cpp4r::rolling::mean(x, width, rolling_options(align, na_rm, partial));
+}
+
+/* roxygen
+@title Rolling Variance on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param width window width
+@param align one of "right", "center" or "left"
+@param na_rm whether to skip missing values
+@param partial whether to summarise incomplete windows at the edges
+@export
+*/
+[[cpp4r::register]] doubles roll_var_(doubles x, int width, std::string align, bool na_rm,
+                                      bool partial) {
+  return cpp4r::rolling::var(x, width, rolling_options(align, na_rm, partial));
+}
+
+/* roxygen
+@title Rolling Minimum on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param width window width
+@param align one of "right", "center" or "left"
+@param na_rm whether to skip missing values
+@param partial whether to summarise incomplete windows at the edges
+@export
+*/
+[[cpp4r::register]] doubles roll_min_(doubles x, int width, std::string align, bool na_rm,
+                                      bool partial) {
+  return cpp4r::rolling::min(x, width, rolling_options(align, na_rm, partial));
+}
+
+/* roxygen
+@title Rolling Maximum on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param width window width
+@param align one of "right", "center" or "left"
+@param na_rm whether to skip missing values
+@param partial whether to summarise incomplete windows at the edges
+@export
+*/
+[[cpp4r::register]] doubles roll_max_(doubles x, int width, std::string align, bool na_rm,
+                                      bool partial) {
+  return cpp4r::rolling::max(x, width, rolling_options(align, na_rm, partial));
+}
+
+/* roxygen
+@title Rolling Median on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param width window width
+@param align one of "right", "center" or "left"
+@param na_rm whether to skip missing values
+@param partial whether to summarise incomplete windows at the edges
+@export
+*/
+[[cpp4r::register]] doubles roll_median_(doubles x, int width, std::string align,
+                                         bool na_rm, bool partial) {
+  return cpp4r::rolling::median(x, width, rolling_options(align, na_rm, partial));
+}
+
+/* R code to benchmark against a naive R loop
+res <- bench::press(
+  n = 10^seq(3, 5),
+  width = c(10, 100),
+  {
+    x <- stats::rnorm(n)
+    bench::mark(
+      vapply(seq_len(n - width + 1), function(i) mean(x[i:(i + width - 1)]), 0),
+      roll_mean_(x, width, "left", FALSE, FALSE)[seq_len(n - width + 1)],
+      check = function(a, b) isTRUE(all.equal(a, b))
+    )
+  }
+)
+*/
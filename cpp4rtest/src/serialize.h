@@ -0,0 +1,86 @@
+/* roxygen
+@title Serialize to a Raw Vector on 'C++' Side
+@description Test suite
+@param x object to serialize
+@param native whether to use R's native binary format instead of XDR
+@export
+*/
+[[cpp4r::register]] cpp4r::raws serialize_raw_(SEXP x, bool native) {
+  return cpp4r::serialize(x, native ? cpp4r::serialize_format::native
+                                    : cpp4r::serialize_format::xdr);
+}
+
+/* roxygen
+@title Unserialize from a Raw Vector on 'C++' Side
+@description Test suite
+@param x raw vector
+@export
+*/
+[[cpp4r::register]] SEXP unserialize_raw_(cpp4r::raws x) {
+  return cpp4r::unserialize(x);
+}
+
+/* roxygen
+@title Serialize to a File on 'C++' Side
+@description Test suite
+@param x object to serialize
+@param path file to write
+@param native whether to use R's native binary format instead of XDR
+@export
+*/
+[[cpp4r::register]] void serialize_file_(SEXP x, std::string path, bool native) {
+  cpp4r::file_sink out(path);
+  cpp4r::serialize(x, out,
+                   native ? cpp4r::serialize_format::native
+                          : cpp4r::serialize_format::xdr);
+  out.close();
+}
+
+/* roxygen
+@title Unserialize from a File on 'C++' Side
+@description Test suite
+@param path file to read
+@export
+*/
+[[cpp4r::register]] SEXP unserialize_file_(std::string path) {
+  cpp4r::file_source in(path);
+  return cpp4r::unserialize(in);
+}
+
+/* roxygen
+@title Serialize Through a Callback on 'C++' Side
+@description Test suite
+@param x object to serialize
+@param chunk size of the buffer handed to the callback
+@export
+*/
+[[cpp4r::register]] cpp4r::doubles serialize_callback_(SEXP x, int chunk) {
+  double bytes = 0., calls = 0.;
+  cpp4r::callback_sink out(
+      [&](const char*, std::size_t n) {
+        bytes += static_cast<double>(n);
+        calls += 1.;
+      },
+      static_cast<std::size_t>(chunk));
+  cpp4r::serialize(x, out);
+  out.flush();
+  return cpp4r::writable::doubles({bytes, calls});
+}
+
+/* R code to benchmark serializing 100 MB of doubles against base R
+x <- runif(12.5e6)
+path <- tempfile()
+bench::mark(
+  serialize(x, NULL),
+  serialize(x, NULL, xdr = FALSE),
+  serialize_raw_(x, FALSE),
+  serialize_raw_(x, TRUE),
+  check = FALSE
+)
+bench::mark(
+  saveRDS(x, path, compress = FALSE),
+  serialize_file_(x, path, FALSE),
+  serialize_file_(x, path, TRUE),
+  check = FALSE
+)
+*/
@@ -0,0 +1,106 @@
+/* roxygen
+@title Order Doubles with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of doubles to order
+@param decreasing whether to sort in decreasing order
+@param na_last whether missing values go last
+@export
+*/
+[[cpp4r::register]] integers order_dbl_(doubles x, bool decreasing, bool na_last) {
+  return cpp4r::order(x, decreasing, na_last);
+}
+
+/* roxygen
+@title Order Integers with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of integers to order
+@param decreasing whether to sort in decreasing order
+@param na_last whether missing values go last
+@export
+*/
+[[cpp4r::register]] integers order_int_(integers x, bool decreasing, bool na_last) {
+  return cpp4r::order(x, decreasing, na_last);
+}
+
+/* roxygen
+@title Order Logicals with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of logicals to order
+@param decreasing whether to sort in decreasing order
+@param na_last whether missing values go last
+@export
+*/
+[[cpp4r::register]] integers order_lgl_(logicals x, bool decreasing, bool na_last) {
+  return cpp4r::order(x, decreasing, na_last);
+}
+
+/* roxygen
+@title Order Strings with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of strings to order
+@param decreasing whether to sort in decreasing order
+@param na_last whether missing values go last
+@param c_locale whether to compare bytes instead of using the locale collation
+@export
+*/
+[[cpp4r::register]] integers order_chr_(strings x, bool decreasing, bool na_last,
+                                        bool c_locale) {
+  return cpp4r::order(x, decreasing, na_last, c_locale);
+}
+
+/* roxygen
+@title Sort Doubles with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of doubles to sort
+@param decreasing whether to sort in decreasing order
+@export
+*/
+[[cpp4r::register]] doubles sort_dbl_(doubles x, bool decreasing) {
+  return cpp4r::sort(x, decreasing);
+}
+
+/* roxygen
+@title Sort Integers with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of integers to sort
+@param decreasing whether to sort in decreasing order
+@export
+*/
+[[cpp4r::register]] integers sort_int_(integers x, bool decreasing) {
+  return cpp4r::sort(x, decreasing);
+}
+
+/* roxygen
+@title Sort Strings with Radix Sort on 'C++' Side
+@description Test suite
+@param x vector of strings to sort
+@param decreasing whether to sort in decreasing order
+@export
+*/
+[[cpp4r::register]] strings sort_chr_(strings x, bool decreasing) {
+  return cpp4r::sort(x, decreasing);
+}
+
+/* R code to benchmark against base R
+res <- bench::press(
+  n = 10^seq(4, 8, by = 2),
+  {
+    x <- stats::runif(n)
+    bench::mark(
+      order(x, method = "radix"),
+      order_dbl_(x, FALSE, TRUE)
+    )
+  }
+)
+
+res_chr <- bench::press(
+  n = 10^seq(4, 6),
+  {
+    x <- sample(as.character(seq_len(n / 10)), n, replace = TRUE)
+    bench::mark(
+      order(x, method = "radix"),
+      order_chr_(x, FALSE, TRUE, TRUE)
+    )
+  }
+)
+*/
@@ -0,0 +1,121 @@
+/* roxygen
+@title Subset Doubles by Position on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param idx integer subscript, as in `x[idx]`
+@export
+*/
+[[cpp4r::register]] doubles subset_dbl_(doubles x, integers idx) {
+  return cpp4r::subset(x, idx);
+}
+
+/* roxygen
+@title Subset Integers by Position on 'C++' Side
+@description Test suite
+@param x vector of integers
+@param idx integer subscript, as in `x[idx]`
+@export
+*/
+[[cpp4r::register]] integers subset_int_(integers x, integers idx) {
+  return cpp4r::subset(x, idx);
+}
+
+/* roxygen
+@title Subset Strings by Position on 'C++' Side
+@description Test suite
+@param x vector of strings
+@param idx integer subscript, as in `x[idx]`
+@export
+*/
+[[cpp4r::register]] strings subset_chr_(strings x, integers idx) {
+  return cpp4r::subset(x, idx);
+}
+
+/* roxygen
+@title Subset Doubles by a Logical Mask on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param mask logical subscript, as in `x[mask]`
+@export
+*/
+[[cpp4r::register]] doubles subset_mask_dbl_(doubles x, logicals mask) {
+  return cpp4r::subset_mask(x, mask);
+}
+
+/* roxygen
+@title Subset Logicals by a Logical Mask on 'C++' Side
+@description Test suite
+@param x vector of logicals
+@param mask logical subscript, as in `x[mask]`
+@export
+*/
+[[cpp4r::register]] logicals subset_mask_lgl_(logicals x, logicals mask) {
+  return cpp4r::subset_mask(x, mask);
+}
+
+/* roxygen
+@title Subset Complexes by a Logical Mask on 'C++' Side
+@description Test suite
+@param x vector of complexes
+@param mask logical subscript, as in `x[mask]`
+@export
+*/
+[[cpp4r::register]] complexes subset_mask_cplx_(complexes x, logicals mask) {
+  return cpp4r::subset_mask(x, mask);
+}
+
+/* roxygen
+@title Subset Raws by a Logical Mask on 'C++' Side
+@description Test suite
+@param x vector of raws
+@param mask logical subscript, as in `x[mask]`
+@export
+*/
+[[cpp4r::register]] raws subset_mask_raw_(raws x, logicals mask) {
+  return cpp4r::subset_mask(x, mask);
+}
+
+/* roxygen
+@title Assign Doubles by Position on 'C++' Side
+@description Test suite
+@param x vector of doubles
+@param idx integer subscript, as in `x[idx] <- values`
+@param values replacement values
+@export
+*/
+[[cpp4r::register]] doubles assign_at_dbl_(doubles x, integers idx, doubles values) {
+  writable::doubles out(x);
+  cpp4r::assign_at(out, idx, values);
+  return out;
+}
+
+/* roxygen
+@title Assign Strings by Position on 'C++' Side
+@description Test suite
+@param x vector of strings
+@param idx integer subscript, as in `x[idx] <- values`
+@param values replacement values
+@export
+*/
+[[cpp4r::register]] strings assign_at_chr_(strings x, integers idx, strings values) {
+  writable::strings out(x);
+  cpp4r::assign_at(out, idx, values);
+  return out;
+}
+
+/* R code to benchmark against base R
+res <- bench::press(
+  n = 10^seq(4, 8, by = 2),
+  {
+    x <- stats::runif(n)
+    idx <- sample.int(n, n, replace = TRUE)
+    mask <- x > 0.5
+    bench::mark(
+      x[idx],
+      subset_dbl_(x, idx),
+      x[mask],
+      subset_mask_dbl_(x, mask)
+    )
+  }
+)
+*/
@@ -195,6 +195,92 @@ int iterator_count_(doubles x, double value) {
   return static_cast<int>(std::distance(x.begin(), x.end()));
 }
 
+/* roxygen
+@title Sort String Vector with std::sort
+@description Test suite
+@param x vector of strings (R)
+@export
+*/
+[[cpp4r::register]] writable::strings iterator_sort_strings_(strings x) {
+  writable::strings result(x);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/* roxygen
+@title Sort Logical Vector with std::sort
+@description Test suite
+@param x vector of logicals (R)
+@export
+*/
+[[cpp4r::register]] writable::logicals iterator_sort_logicals_(logicals x) {
+  writable::logicals result(x);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/* roxygen
+@title Sort Complex Vector with std::sort
+@description Test suite
+@param x vector of complex numbers (R)
+@export
+*/
+[[cpp4r::register]] writable::complexes iterator_sort_complexes_(complexes x) {
+  writable::complexes result(x);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/* roxygen
+@title Partially Sort String Vector with std::nth_element
+@description Test suite
+@param x vector of strings (R)
+@param n position of the element to place (1-based)
+@export
+*/
+[[cpp4r::register]] r_string iterator_nth_string_(strings x, int n) {
+  writable::strings result(x);
+  std::nth_element(result.begin(), result.begin() + (n - 1), result.end());
+  return result.begin()[n - 1];
+}
+
+/* roxygen
+@title Reverse List with std::reverse
+@description Test suite
+@param x list (R)
+@export
+*/
+[[cpp4r::register]] writable::list iterator_reverse_list_(list x) {
+  writable::list result(x);
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+/* roxygen
+@title Random Access on String Vector Iterators
+@description Test suite
+@param x vector of strings (R)
+@param index index of the element to access (0-based)
+@export
+*/
+[[cpp4r::register]] r_string iterator_string_at_(strings x, int index) {
+  auto first = x.begin();
+  auto last = x.end();
+  if (!(first + index < last) || last - first != x.size()) {
+    stop("Invalid iterator arithmetic");
+  }
+  return first[index];
+}
+
+/* R code to benchmark std::sort on strings
+x <- as.character(sample.int(1e7))
+bench::mark(
+  sort(x, method = "radix"),
+  iterator_sort_strings_(x),
+  check = FALSE
+)
+*/
+
 /* roxygen
 @title Copy Raw Vector
 @description Test suite
@@ -58,3 +58,60 @@ using namespace cpp4r;
   cpp4r::weak_ref wr(vec, R_NilValue);
   UNPROTECT(1);
 }
+
+inline cpp4r::memo_cache<cpp4r::environment, std::vector<double>>& memo_sorted_cache() {
+  static cpp4r::memo_cache<cpp4r::environment, std::vector<double>> cache(2);
+  return cache;
+}
+
+/* roxygen
+@title Median of a Cached Sorted Copy on 'C++' Side
+@description Test suite
+@param env R environment holding a numeric vector `x`, sorted once per environment
+@export
+*/
+[[cpp4r::register]] double memo_median_(cpp4r::environment env) {
+  const std::vector<double>& sorted =
+      memo_sorted_cache().get_or_compute(env, [](SEXP env) {
+        SEXP values = cpp4r::environment(env)["x"];
+        cpp4r::doubles x(values);
+        std::vector<double> out(x.begin(), x.end());
+        std::sort(out.begin(), out.end());
+        return out;
+      });
+  if (sorted.empty()) {
+    return NA_REAL;
+  }
+  const std::size_t mid = sorted.size() / 2;
+  return sorted.size() % 2 == 1 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+/* roxygen
+@title Memoization Cache Counters on 'C++' Side
+@description Test suite
+@param reset whether to clear the cache and its counters first
+@export
+*/
+[[cpp4r::register]] cpp4r::integers memo_stats_(bool reset) {
+  auto& cache = memo_sorted_cache();
+  if (reset) {
+    cache.clear();
+    cache.reset_counters();
+  }
+  cache.purge();
+  cpp4r::writable::integers out(
+      {static_cast<int>(cache.hits()), static_cast<int>(cache.misses()),
+       static_cast<int>(cache.size()), static_cast<int>(cache.evictions()),
+       static_cast<int>(cpp4r::detail::memo_collected())});
+  out.names() = {"hits", "misses", "size", "evictions", "collected"};
+  return out;
+}
+
+/* R code to benchmark recomputing against the memoization cache
+e <- new.env()
+e$x <- runif(1e6)
+bench::mark(
+  median(e$x),
+  memo_median_(e)
+)
+*/
@@ -5,6 +5,13 @@
 #include "cpp4r/declarations.hpp"
 #include <R_ext/Visibility.h>
 
+// cpp4r_blas_ols.cpp
+doubles_matrix<> blas_ols_(doubles_matrix<> X, doubles_matrix<> Y);
+extern "C" SEXP _cpp4rols_blas_ols_(SEXP X, SEXP Y) {
+  BEGIN_CPP4R
+    return cpp4r::as_sexp(blas_ols_(cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(X), cpp4r::as_cpp<cpp4r::decay_t<doubles_matrix<>>>(Y)));
+  END_CPP4R
+}
 // cpp4r_naive_ols.cpp
 doubles_matrix<> naive_ols_(doubles_matrix<> X, doubles_matrix<> Y);
 extern "C" SEXP _cpp4rols_naive_ols_(SEXP X, SEXP Y) {
@@ -15,6 +22,7 @@ extern "C" SEXP _cpp4rols_naive_ols_(SEXP X, SEXP Y) {
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
+    {"_cpp4rols_blas_ols_",  (DL_FUNC) &_cpp4rols_blas_ols_,  2},
     {"_cpp4rols_naive_ols_", (DL_FUNC) &_cpp4rols_naive_ols_, 2},
     {NULL, NULL, 0}
 };
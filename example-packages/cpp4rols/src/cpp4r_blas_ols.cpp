@@ -0,0 +1,27 @@
+#include <cpp4r.hpp>
+#include <cpp4r/linalg.hpp>
+
+using namespace cpp4r;
+
+[[cpp4r::register]]
+doubles_matrix<> blas_ols_(doubles_matrix<> X, doubles_matrix<> Y) {
+  // 1. Check dimensions
+
+  if (X.nrow() != Y.nrow()) {
+    stop("X and Y must have the same number of rows");
+  }
+
+  if (Y.ncol() != 1) {
+    stop("Y must have only one column");
+  }
+
+  // 2. Compute X'X and X'Y with BLAS (dsyrk and dgemm)
+
+  doubles_matrix<> XtX = linalg::syrk(X);
+  doubles_matrix<> XtY = linalg::gemm(X, Y, true, false);
+
+  // 3. Solve (X'X) b = X'Y with the Cholesky factorization of X'X (LAPACK dpotrf and
+  // dpotrs) instead of inverting X'X
+
+  return linalg::potrs(linalg::potrf(XtX), XtY);
+}
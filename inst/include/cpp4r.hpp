@@ -1,26 +1,44 @@
 #pragma once
 
 #include "cpp4r/R.hpp"
+#include "cpp4r/array.hpp"
+#include "cpp4r/arrow.hpp"
 #include "cpp4r/as.hpp"
 #include "cpp4r/attribute_proxy.hpp"
+#include "cpp4r/coercing_matrix.hpp"
 #include "cpp4r/complexes.hpp"
 #include "cpp4r/data_frame.hpp"
+#include "cpp4r/data_frame_builder.hpp"
+#include "cpp4r/data_frame_of.hpp"
 #include "cpp4r/doubles.hpp"
 #include "cpp4r/environment.hpp"
 #include "cpp4r/external_pointer.hpp"
+#include "cpp4r/find_interval.hpp"
 #include "cpp4r/function.hpp"
+#include "cpp4r/group_by.hpp"
 #include "cpp4r/integers.hpp"
+#include "cpp4r/join.hpp"
 #include "cpp4r/list.hpp"
 #include "cpp4r/list_of.hpp"
 #include "cpp4r/logicals.hpp"
 #include "cpp4r/matrix.hpp"
+#include "cpp4r/memo_cache.hpp"
 #include "cpp4r/named_arg.hpp"
+#include "cpp4r/object_pool.hpp"
 #include "cpp4r/pairlist.hpp"
 #include "cpp4r/protect.hpp"
 #include "cpp4r/r_bool.hpp"
 #include "cpp4r/r_string.hpp"
 #include "cpp4r/r_vector.hpp"
+#include "cpp4r/raw_io.hpp"
+#include "cpp4r/raw_streambuf.hpp"
 #include "cpp4r/raws.hpp"
+#include "cpp4r/rolling.hpp"
+#include "cpp4r/serializable_pointer.hpp"
+#include "cpp4r/serialize.hpp"
 #include "cpp4r/sexp.hpp"
+#include "cpp4r/sort.hpp"
 #include "cpp4r/strings.hpp"
+#include "cpp4r/subset.hpp"
+#include "cpp4r/symbol.hpp"
 #include "cpp4r/weak_ref.hpp"
@@ -114,6 +114,19 @@ inline bool r_env_has(SEXP env, SEXP sym) {
 #endif
 }
 
+// Get an object from an environment, or `if_missing` when it isn't bound there
+//
+// SAFETY: Keep as a pure C function. Call like an R API function, i.e. wrap in `safe[]`
+// as required.
+inline SEXP r_env_get_or(SEXP env, SEXP sym, SEXP if_missing) {
+#if defined(R_VERSION) && R_VERSION >= R_Version(4, 5, 0)
+  const Rboolean inherits = FALSE;
+  return R_getVarEx(sym, env, inherits, if_missing);
+#else
+  return r_env_has(env, sym) ? r_env_get(env, sym) : if_missing;
+#endif
+}
+
 }  // namespace detail
 
 template <typename T>
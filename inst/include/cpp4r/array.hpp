@@ -0,0 +1,383 @@
+#pragma once
+
+#include <array>             // for array
+#include <cstddef>           // for size_t
+#include <initializer_list>  // for initializer_list
+#include <type_traits>       // for enable_if, declval
+#include <utility>           // for move
+#include <vector>            // for vector
+
+#include "cpp4r/R.hpp"         // for SEXP, R_xlen_t, R_DimSymbol
+#include "cpp4r/doubles.hpp"   // for writable::doubles
+#include "cpp4r/integers.hpp"  // for writable::integers
+#include "cpp4r/matrix.hpp"    // for detail::get_sexptype_v, detail::coerce_matrix_sexp
+#include "cpp4r/protect.hpp"   // for stop, safe
+#include "cpp4r/r_bool.hpp"    // for r_bool
+#include "cpp4r/r_vector.hpp"  // for r_vector
+
+// N-dimensional arrays on top of the `dim` attribute.
+//
+// `array<T, N>` (read-only) and `writable::array<T, N>` index a vector with `N` dims in
+// R's column-major order: axis 0 varies fastest. `view()`, `slice()` and `sub()` return
+// `array_view`s, which describe a strided subset of the same vector (an offset plus an
+// extent and a stride per axis, like `std::mdspan`) without copying it. Views of a
+// writable array are writable.
+//
+// `for_each()` and the reductions over chosen axes (`sum()`, `mean()`, `reduce()`) visit
+// the elements with axis 0 innermost, which is memory order for arrays and their slices.
+
+namespace cpp4r {
+
+template <typename V, int N>
+class basic_array;
+
+namespace detail {
+
+// Element of a numeric array as a double, with `NA` as `NA_real_`
+inline double array_as_double(double x) { return x; }
+inline double array_as_double(int x) {
+  return x == NA_INTEGER ? NA_REAL : static_cast<double>(x);
+}
+inline double array_as_double(r_bool x) { return array_as_double(static_cast<int>(x)); }
+
+template <int N>
+std::array<R_xlen_t, N> column_major_strides(const std::array<R_xlen_t, N>& extents) {
+  std::array<R_xlen_t, N> strides;
+  R_xlen_t stride = 1;
+  for (int k = 0; k < N; ++k) {
+    strides[k] = stride;
+    stride *= extents[k];
+  }
+  return strides;
+}
+
+inline void check_axis(int axis, int rank) {
+  if (axis < 0 || axis >= rank) {
+    stop("Axis %d is out of range for an array of rank %d", axis, rank);
+  }
+}
+
+}  // namespace detail
+
+// A rank `N` strided view of the vector `V` of an array, which has to outlive it
+template <typename V, int N>
+class array_view {
+ public:
+  using underlying_type = typename V::underlying_type;
+  using index_type = std::array<R_xlen_t, N>;
+  // `T` for read-only arrays, an assignable reference for writable ones
+  using reference = decltype(std::declval<const V&>()[R_xlen_t()]);
+
+ private:
+  const V* vector_;
+  R_xlen_t offset_;
+  index_type extents_, strides_;
+
+  template <typename V2, int N2>
+  friend class array_view;
+
+  // Calls `f(index, offset)` for every element, with axis 0 innermost
+  template <typename F>
+  void walk(F f) const {
+    if (size() == 0) {
+      return;
+    }
+    index_type index{};
+    R_xlen_t offset = offset_;
+    while (true) {
+      f(index, offset);
+      int k = 0;
+      for (; k < N; ++k) {
+        offset += strides_[k];
+        if (++index[k] < extents_[k]) break;
+        offset -= strides_[k] * extents_[k];
+        index[k] = 0;
+      }
+      if (k == N) break;
+    }
+  }
+
+ public:
+  array_view(const V* vector, R_xlen_t offset, const index_type& extents,
+             const index_type& strides)
+      : vector_(vector), offset_(offset), extents_(extents), strides_(strides) {}
+
+  static constexpr int rank() noexcept { return N; }
+  R_xlen_t extent(int axis) const noexcept { return extents_[axis]; }
+  R_xlen_t stride(int axis) const noexcept { return strides_[axis]; }
+  const index_type& extents() const noexcept { return extents_; }
+  const index_type& strides() const noexcept { return strides_; }
+  R_xlen_t offset() const noexcept { return offset_; }
+
+  R_xlen_t size() const noexcept {
+    R_xlen_t out = 1;
+    for (int k = 0; k < N; ++k) out *= extents_[k];
+    return out;
+  }
+
+  // Address of element `(0, ..., 0)`, or `nullptr` when the vector has no raw data
+  // pointer (ALTREP and strings)
+  const underlying_type* data_ptr() const noexcept {
+    const underlying_type* p = vector_->data_ptr();
+    return p == nullptr ? nullptr : p + offset_;
+  }
+
+  CPP4R_ALWAYS_INLINE reference operator[](const index_type& index) const {
+    R_xlen_t pos = offset_;
+    for (int k = 0; k < N; ++k) pos += index[k] * strides_[k];
+    return (*vector_)[pos];
+  }
+
+  template <typename... I>
+  CPP4R_ALWAYS_INLINE reference operator()(I... index) const {
+    static_assert(sizeof...(I) == N, "An array of rank N takes N indices");
+    return operator[](index_type{{static_cast<R_xlen_t>(index)...}});
+  }
+
+  // The rank `N - 1` view at position `index` of `axis`
+  array_view<V, N - 1> slice(int axis, R_xlen_t index) const {
+    static_assert(N > 1, "Slicing a rank 1 view would give a single element");
+    detail::check_axis(axis, N);
+    if (index < 0 || index >= extents_[axis]) {
+      stop("Index %lld is out of range for axis %d of extent %lld",
+           static_cast<long long>(index), axis, static_cast<long long>(extents_[axis]));
+    }
+    std::array<R_xlen_t, N - 1> extents, strides;
+    for (int k = 0, out = 0; k < N; ++k) {
+      if (k == axis) continue;
+      extents[out] = extents_[k];
+      strides[out] = strides_[k];
+      ++out;
+    }
+    return {vector_, offset_ + index * strides_[axis], extents, strides};
+  }
+
+  // The `length` positions of `axis` starting at `start`, with every other axis whole
+  array_view sub(int axis, R_xlen_t start, R_xlen_t length) const {
+    detail::check_axis(axis, N);
+    if (start < 0 || length < 0 || start > extents_[axis] - length) {
+      stop("Range [%lld, %lld) is out of range for axis %d of extent %lld",
+           static_cast<long long>(start), static_cast<long long>(start + length), axis,
+           static_cast<long long>(extents_[axis]));
+    }
+    index_type extents = extents_;
+    extents[axis] = length;
+    return {vector_, offset_ + start * strides_[axis], extents, strides_};
+  }
+
+  // Calls `f(index, value)` for every element, with axis 0 innermost
+  template <typename F>
+  void for_each(F f) const {
+    const V& vector = *vector_;
+    walk([&](const index_type& index, R_xlen_t pos) { f(index, vector[pos]); });
+  }
+
+  // Folds the elements along `axes` with `op(accumulated, value)` starting from `init`.
+  // The result has one element per position of the other axes (in column-major order),
+  // with their extents as `dim` when two or more are left, like `apply()`.
+  template <typename Op>
+  writable::doubles reduce(const std::vector<int>& axes, double init, Op op) const {
+    std::array<bool, N> reduced{};
+    for (int axis : axes) {
+      detail::check_axis(axis, N);
+      reduced[axis] = true;
+    }
+
+    index_type out_strides;
+    R_xlen_t out_size = 1;
+    writable::integers out_dim;
+    for (int k = 0; k < N; ++k) {
+      out_strides[k] = reduced[k] ? 0 : out_size;
+      if (!reduced[k]) {
+        out_size *= extents_[k];
+        out_dim.push_back(static_cast<int>(extents_[k]));
+      }
+    }
+
+    writable::doubles out(out_size);
+    double* po = REAL(out.data());
+    for (R_xlen_t i = 0; i < out_size; ++i) po[i] = init;
+
+    // Axis 0 is handled a whole run at a time, the others by `walk()`
+    const R_xlen_t n0 = extents_[0];
+    const R_xlen_t s0 = strides_[0];
+    const R_xlen_t o0 = out_strides[0];
+    index_type outer_extents = extents_;
+    outer_extents[0] = n0 > 0 ? 1 : 0;
+    const array_view outer(vector_, offset_, outer_extents, strides_);
+    const underlying_type* p = vector_->data_ptr();
+    const V& vector = *vector_;
+    outer.walk([&](const index_type& index, R_xlen_t pos) {
+      R_xlen_t o = 0;
+      for (int k = 1; k < N; ++k) o += index[k] * out_strides[k];
+      double* acc = po + o;
+      if (p != nullptr) {
+        for (R_xlen_t i = 0; i < n0; ++i) {
+          acc[i * o0] = op(acc[i * o0], detail::array_as_double(p[pos + i * s0]));
+        }
+      } else {
+        for (R_xlen_t i = 0; i < n0; ++i) {
+          acc[i * o0] = op(acc[i * o0], detail::array_as_double(vector[pos + i * s0]));
+        }
+      }
+    });
+
+    if (out_dim.size() >= 2) {
+      out.attr(R_DimSymbol) = out_dim;
+    }
+    return out;
+  }
+
+  // Sums over `axes`, like `apply(x, <other axes>, sum)`
+  writable::doubles sum(const std::vector<int>& axes) const {
+    return reduce(axes, 0., [](double acc, double x) { return acc + x; });
+  }
+
+  // Means over `axes`, like `apply(x, <other axes>, mean)`
+  writable::doubles mean(const std::vector<int>& axes) const {
+    writable::doubles out = sum(axes);
+    R_xlen_t count = 1;
+    for (int k = 0; k < N; ++k) {
+      for (int axis : axes) {
+        if (axis == k) {
+          count *= extents_[k];
+          break;
+        }
+      }
+    }
+    double* po = REAL(out.data());
+    for (R_xlen_t i = 0; i < out.size(); ++i) po[i] /= count;
+    return out;
+  }
+};
+
+template <typename V, int N>
+class basic_array {
+  V vector_;
+  std::array<R_xlen_t, N> dims_, strides_;
+
+  template <typename V2, int N2>
+  friend class basic_array;
+
+  static std::array<R_xlen_t, N> read_dims(SEXP data) {
+    std::array<R_xlen_t, N> dims;
+    SEXP dim = Rf_getAttrib(data, R_DimSymbol);
+    if (dim == R_NilValue && N == 1) {
+      dims[0] = Rf_xlength(data);
+      return dims;
+    }
+    const R_xlen_t rank = dim == R_NilValue ? 0 : Rf_xlength(dim);
+    if (rank != N) {
+      stop("Expected an array with %d dimensions, got %d", N, static_cast<int>(rank));
+    }
+    for (int k = 0; k < N; ++k) dims[k] = INTEGER(dim)[k];
+    return dims;
+  }
+
+  static SEXP alloc(const std::array<int, N>& dims) {
+    writable::integers dim(N);
+    for (int k = 0; k < N; ++k) dim[k] = dims[k];
+    const SEXPTYPE type = detail::get_sexptype_v<typename V::scalar_type>::value;
+    return safe[Rf_allocArray](type, dim);
+  }
+
+ public:
+  using underlying_type = typename V::underlying_type;
+  using scalar_type = typename V::scalar_type;
+  using view_type = array_view<V, N>;
+  using index_type = typename view_type::index_type;
+
+  basic_array(SEXP data)
+      : vector_(detail::coerce_matrix_sexp<scalar_type>(data)),
+        dims_(read_dims(data)),
+        strides_(detail::column_major_strides<N>(dims_)) {}
+
+  // A new array with extents `dims`
+  explicit basic_array(const std::array<int, N>& dims)
+      : vector_(alloc(dims), writable::fresh_allocation_tag{}) {
+    for (int k = 0; k < N; ++k) dims_[k] = dims[k];
+    strides_ = detail::column_major_strides<N>(dims_);
+  }
+
+  template <typename V2>
+  basic_array(const basic_array<V2, N>& rhs)
+      : vector_(rhs.vector_), dims_(rhs.dims_), strides_(rhs.strides_) {}
+
+  template <typename V2>
+  basic_array(basic_array<V2, N>&& rhs)
+      : vector_(std::move(rhs.vector_)), dims_(rhs.dims_), strides_(rhs.strides_) {}
+
+  static constexpr int rank() noexcept { return N; }
+  int dim(int axis) const noexcept { return static_cast<int>(dims_[axis]); }
+  const std::array<R_xlen_t, N>& extents() const noexcept { return dims_; }
+  const std::array<R_xlen_t, N>& strides() const noexcept { return strides_; }
+
+  V vector() const { return vector_; }
+  SEXP data() const { return vector_.data(); }
+  R_xlen_t size() const { return vector_.size(); }
+  operator SEXP() const { return SEXP(vector_); }
+
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE const underlying_type* data_ptr() const noexcept {
+    return vector_.data_ptr();
+  }
+
+  template <typename V2 = V>
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE underlying_type* data_ptr_writable() noexcept {
+    return vector_.data_ptr_writable();
+  }
+
+  template <typename... I>
+  CPP4R_ALWAYS_INLINE scalar_type operator()(I... index) const {
+    return vector_[offset(index...)];
+  }
+
+  template <typename... I, typename V2 = V,
+            typename = decltype(std::declval<V2>().data_ptr_writable())>
+  CPP4R_ALWAYS_INLINE typename V2::reference operator()(I... index) {
+    return vector_[offset(index...)];
+  }
+
+  // Column-major offset of an element
+  template <typename... I>
+  CPP4R_ALWAYS_INLINE R_xlen_t offset(I... index) const noexcept {
+    static_assert(sizeof...(I) == N, "An array of rank N takes N indices");
+    const R_xlen_t idx[] = {static_cast<R_xlen_t>(index)...};
+    R_xlen_t pos = 0;
+    for (int k = 0; k < N; ++k) pos += idx[k] * strides_[k];
+    return pos;
+  }
+
+  // The whole array as a view
+  view_type view() const { return {&vector_, 0, dims_, strides_}; }
+
+  array_view<V, N - 1> slice(int axis, R_xlen_t index) const {
+    return view().slice(axis, index);
+  }
+  view_type sub(int axis, R_xlen_t start, R_xlen_t length) const {
+    return view().sub(axis, start, length);
+  }
+
+  template <typename F>
+  void for_each(F f) const {
+    view().for_each(f);
+  }
+
+  template <typename Op>
+  writable::doubles reduce(const std::vector<int>& axes, double init, Op op) const {
+    return view().reduce(axes, init, op);
+  }
+  writable::doubles sum(const std::vector<int>& axes) const { return view().sum(axes); }
+  writable::doubles mean(const std::vector<int>& axes) const {
+    return view().mean(axes);
+  }
+};
+
+template <typename T, int N>
+using array = basic_array<r_vector<T>, N>;
+
+namespace writable {
+template <typename T, int N>
+using array = basic_array<r_vector<T>, N>;
+}  // namespace writable
+
+}  // namespace cpp4r
@@ -0,0 +1,595 @@
+#pragma once
+
+#include <algorithm>  // for min
+#include <cstdint>    // for int64_t, uint8_t
+#include <cstring>    // for memcpy, strcmp
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include "cpp4r/R.hpp"                 // for SEXP, REAL_RO, INTEGER_RO, RAW_RO
+#include "cpp4r/data_frame.hpp"        // for data_frame
+#include "cpp4r/external_pointer.hpp"  // for external_pointer
+#include "cpp4r/list.hpp"              // for writable::list
+#include "cpp4r/protect.hpp"           // for safe, stop, detail::store
+#include "cpp4r/sexp.hpp"              // for sexp
+#include "cpp4r/strings.hpp"           // for writable::strings
+
+// After cpp4r/R.hpp, which sets up the R headers
+#include <R_ext/Altrep.h>  // for R_altrep_class_t, R_new_altrep, R_make_altreal_class
+
+// The structs of the Arrow C data interface, as specified in
+// https://arrow.apache.org/docs/format/CDataInterface.html. The guard is the one the
+// specification asks for, so they can be included along with Arrow's own headers.
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+}  // extern "C"
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+// Exchange of columnar data with Arrow-based libraries, without copying it and without
+// depending on Arrow.
+//
+// `export_arrow(x, &array, &schema)` describes a double, integer or raw vector, or a
+// data frame of them, as an `ArrowArray` and an `ArrowSchema`. The array points straight
+// into the memory of the vectors, which stay protected until the consumer calls its
+// `release` callback. R's `NA`s become nulls: the validity bitmap is the only buffer
+// that is allocated, and only when there is an `NA`. Attributes, such as classes and
+// factor levels, are not exported.
+//
+// `import_arrow(&array, &schema)` takes ownership of an array of doubles (`g`), 32-bit
+// integers (`i`) or bytes (`C`), or of a struct (`+s`) of them, which becomes a data
+// frame. Each array becomes an ALTREP vector that reads the Arrow buffer in place. An
+// array without nulls is never copied, unless it is written to. Otherwise it is copied,
+// with its nulls as `NA` (0 for raw vectors), the first time R needs a data pointer.
+// The Arrow array is released when the vector is garbage collected, since pointers
+// into its buffers may have been handed out before the copy was made. Integers equal
+// to `NA_integer_` read as `NA`.
+//
+// The ALTREP classes must be registered while the package is loaded, e.g.
+//
+//   [[cpp4r::init]] void init_arrow(DllInfo* dll) { cpp4r::init_arrow(dll, "pkg"); }
+//
+// Release callbacks of exported arrays and schemas must be called on R's main thread,
+// as must R's finalizers for imported ones.
+
+namespace cpp4r {
+
+namespace detail {
+
+template <typename T>
+struct arrow_traits;
+
+template <>
+struct arrow_traits<double> {
+  static SEXPTYPE type() { return REALSXP; }
+  static const char* format() { return "g"; }
+  static double na() { return NA_REAL; }
+  static bool is_na(double x) { return R_IsNA(x); }
+  static double* ptr(SEXP x) { return REAL(x); }
+  static const double* ptr_ro(SEXP x) { return REAL_RO(x); }
+  static R_altrep_class_t make_class(const char* name, const char* package,
+                                     DllInfo* dll) {
+    return R_make_altreal_class(name, package, dll);
+  }
+  template <typename Elt, typename Region>
+  static void set_methods(R_altrep_class_t cls, Elt elt, Region region) {
+    R_set_altreal_Elt_method(cls, elt);
+    R_set_altreal_Get_region_method(cls, region);
+  }
+};
+
+template <>
+struct arrow_traits<int> {
+  static SEXPTYPE type() { return INTSXP; }
+  static const char* format() { return "i"; }
+  static int na() { return NA_INTEGER; }
+  static bool is_na(int x) { return x == NA_INTEGER; }
+  static int* ptr(SEXP x) { return INTEGER(x); }
+  static const int* ptr_ro(SEXP x) { return INTEGER_RO(x); }
+  static R_altrep_class_t make_class(const char* name, const char* package,
+                                     DllInfo* dll) {
+    return R_make_altinteger_class(name, package, dll);
+  }
+  template <typename Elt, typename Region>
+  static void set_methods(R_altrep_class_t cls, Elt elt, Region region) {
+    R_set_altinteger_Elt_method(cls, elt);
+    R_set_altinteger_Get_region_method(cls, region);
+  }
+};
+
+template <>
+struct arrow_traits<Rbyte> {
+  static SEXPTYPE type() { return RAWSXP; }
+  static const char* format() { return "C"; }
+  static Rbyte na() { return 0; }
+  static bool is_na(Rbyte) { return false; }
+  static Rbyte* ptr(SEXP x) { return RAW(x); }
+  static const Rbyte* ptr_ro(SEXP x) { return RAW_RO(x); }
+  static R_altrep_class_t make_class(const char* name, const char* package,
+                                     DllInfo* dll) {
+    return R_make_altraw_class(name, package, dll);
+  }
+  template <typename Elt, typename Region>
+  static void set_methods(R_altrep_class_t cls, Elt elt, Region region) {
+    R_set_altraw_Elt_method(cls, elt);
+    R_set_altraw_Get_region_method(cls, region);
+  }
+};
+
+inline bool is_data_frame(SEXP x) {
+  return detail::r_typeof(x) == VECSXP && Rf_inherits(x, "data.frame");
+}
+
+// Export
+
+struct arrow_array_data {
+  SEXP protect = R_NilValue;
+  std::vector<uint8_t> validity;
+  const void* buffers[2] = {nullptr, nullptr};
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_pointers;
+
+  arrow_array_data() = default;
+  arrow_array_data(const arrow_array_data&) = delete;
+  arrow_array_data& operator=(const arrow_array_data&) = delete;
+
+  // Children the consumer moved out have been marked released
+  ~arrow_array_data() {
+    for (ArrowArray& child : children) {
+      if (child.release != nullptr) {
+        child.release(&child);
+      }
+    }
+    store::release(protect);
+  }
+};
+
+inline void arrow_release_array(ArrowArray* array) {
+  delete static_cast<arrow_array_data*>(array->private_data);
+  array->release = nullptr;
+}
+
+struct arrow_schema_data {
+  std::string format;
+  std::string name;
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema*> child_pointers;
+
+  arrow_schema_data() = default;
+  arrow_schema_data(const arrow_schema_data&) = delete;
+  arrow_schema_data& operator=(const arrow_schema_data&) = delete;
+
+  ~arrow_schema_data() {
+    for (ArrowSchema& child : children) {
+      if (child.release != nullptr) {
+        child.release(&child);
+      }
+    }
+  }
+};
+
+inline void arrow_release_schema(ArrowSchema* schema) {
+  delete static_cast<arrow_schema_data*>(schema->private_data);
+  schema->release = nullptr;
+}
+
+inline const char* arrow_format(SEXP x) {
+  switch (detail::r_typeof(x)) {
+    case REALSXP:
+      return arrow_traits<double>::format();
+    case INTSXP:
+      return arrow_traits<int>::format();
+    case RAWSXP:
+      return arrow_traits<Rbyte>::format();
+    default:
+      stop("Can't export a vector of type '%s' to Arrow",
+           Rf_type2char(detail::r_typeof(x)));
+  }
+}
+
+// Clears the bit of each `NA` in `bitmap`, which is only allocated if there is one.
+// Returns the number of `NA`s.
+template <typename T>
+int64_t arrow_validity(const T* values, R_xlen_t n, std::vector<uint8_t>& bitmap) {
+  int64_t nulls = 0;
+  for (R_xlen_t i = 0; i < n; ++i) {
+    if (arrow_traits<T>::is_na(values[i])) {
+      if (bitmap.empty()) {
+        bitmap.assign(static_cast<std::size_t>((n + 7) / 8), 0xFF);
+      }
+      bitmap[i >> 3] &= static_cast<uint8_t>(~(1u << (i & 7)));
+      ++nulls;
+    }
+  }
+  return nulls;
+}
+
+inline void arrow_export_schema(SEXP x, const char* name, ArrowSchema* out) {
+  std::unique_ptr<arrow_schema_data> data(new arrow_schema_data());
+  data->name = name;
+  if (is_data_frame(x)) {
+    data->format = "+s";
+    SEXP names = Rf_getAttrib(x, R_NamesSymbol);
+    const R_xlen_t n = Rf_xlength(x);
+    data->children.resize(static_cast<std::size_t>(n), ArrowSchema());
+    for (R_xlen_t i = 0; i < n; ++i) {
+      const char* child_name = names == R_NilValue ? "" : CHAR(STRING_ELT(names, i));
+      arrow_export_schema(VECTOR_ELT(x, i), child_name, &data->children[i]);
+      data->child_pointers.push_back(&data->children[i]);
+    }
+  } else {
+    data->format = arrow_format(x);
+  }
+
+  out->format = data->format.c_str();
+  out->name = data->name.c_str();
+  out->metadata = nullptr;
+  out->flags = ARROW_FLAG_NULLABLE;
+  out->n_children = static_cast<int64_t>(data->children.size());
+  out->children = data->child_pointers.empty() ? nullptr : data->child_pointers.data();
+  out->dictionary = nullptr;
+  out->release = arrow_release_schema;
+  out->private_data = data.release();
+}
+
+template <typename T>
+void arrow_export_vector(SEXP x, arrow_array_data& data, ArrowArray* out) {
+  const R_xlen_t n = Rf_xlength(x);
+  const T* values = n > 0 ? arrow_traits<T>::ptr_ro(x) : nullptr;
+  out->null_count = arrow_validity(values, n, data.validity);
+  data.buffers[0] = data.validity.empty() ? nullptr : data.validity.data();
+  data.buffers[1] = values;
+  out->length = n;
+}
+
+inline void arrow_export_array(SEXP x, ArrowArray* out) {
+  std::unique_ptr<arrow_array_data> data(new arrow_array_data());
+  out->offset = 0;
+  out->dictionary = nullptr;
+  if (is_data_frame(x)) {
+    const R_xlen_t n = Rf_xlength(x);
+    data->children.resize(static_cast<std::size_t>(n), ArrowArray());
+    for (R_xlen_t i = 0; i < n; ++i) {
+      arrow_export_array(VECTOR_ELT(x, i), &data->children[i]);
+      data->child_pointers.push_back(&data->children[i]);
+    }
+    out->length = data_frame(x).nrow();
+    out->null_count = 0;
+    out->n_buffers = 1;
+  } else {
+    switch (detail::r_typeof(x)) {
+      case REALSXP:
+        arrow_export_vector<double>(x, *data, out);
+        break;
+      case INTSXP:
+        arrow_export_vector<int>(x, *data, out);
+        break;
+      case RAWSXP:
+        arrow_export_vector<Rbyte>(x, *data, out);
+        break;
+      default:
+        arrow_format(x);  // throws
+    }
+    out->n_buffers = 2;
+    data->protect = store::insert(x);
+  }
+  out->n_children = static_cast<int64_t>(data->children.size());
+  out->children = data->child_pointers.empty() ? nullptr : data->child_pointers.data();
+  out->buffers = data->buffers;
+  out->release = arrow_release_array;
+  out->private_data = data.release();
+}
+
+// Import
+
+struct arrow_import_data {
+  ArrowArray array;
+  R_xlen_t length = 0;
+
+  arrow_import_data() { array.release = nullptr; }
+  arrow_import_data(const arrow_import_data&) = delete;
+  arrow_import_data& operator=(const arrow_import_data&) = delete;
+  ~arrow_import_data() { release(); }
+
+  void release() {
+    if (array.release != nullptr) {
+      array.release(&array);
+      array.release = nullptr;
+    }
+  }
+};
+
+inline int64_t arrow_count_nulls(const uint8_t* bitmap, int64_t offset, int64_t length) {
+  int64_t nulls = 0;
+  for (int64_t i = offset; i < offset + length; ++i) {
+    nulls += !((bitmap[i >> 3] >> (i & 7)) & 1);
+  }
+  return nulls;
+}
+
+template <typename T>
+class arrow_vector {
+  using traits = arrow_traits<T>;
+
+  static R_altrep_class_t& altrep_class() {
+    static R_altrep_class_t cls;
+    return cls;
+  }
+
+  static arrow_import_data* data(SEXP x) {
+    return static_cast<arrow_import_data*>(R_ExternalPtrAddr(R_altrep_data1(x)));
+  }
+
+  static const T* values(const ArrowArray& array) {
+    const T* values = static_cast<const T*>(array.buffers[1]);
+    return values == nullptr ? nullptr : values + array.offset;
+  }
+
+  static bool has_nulls(const ArrowArray& array) {
+    return array.null_count != 0 && array.buffers[0] != nullptr;
+  }
+
+  static bool valid(const ArrowArray& array, R_xlen_t i) {
+    const uint8_t* bitmap = static_cast<const uint8_t*>(array.buffers[0]);
+    const int64_t j = array.offset + i;
+    return (bitmap[j >> 3] >> (j & 7)) & 1;
+  }
+
+  static R_xlen_t length(SEXP x) { return data(x)->length; }
+
+  // Copies the array into an ordinary vector, with nulls as `NA`
+  static SEXP materialize(SEXP x) {
+    SEXP out = R_altrep_data2(x);
+    if (out != R_NilValue) {
+      return out;
+    }
+    arrow_import_data* d = data(x);
+    out = PROTECT(Rf_allocVector(traits::type(), d->length));
+    get_region(x, 0, d->length, traits::ptr(out));
+    R_set_altrep_data2(x, out);
+    UNPROTECT(1);
+    return out;
+  }
+
+  // The Arrow buffer, unless it has nulls, or an ordinary vector once copied
+  static const void* dataptr_or_null(SEXP x) {
+    SEXP materialized = R_altrep_data2(x);
+    if (materialized != R_NilValue) {
+      return traits::ptr(materialized);
+    }
+    const ArrowArray& array = data(x)->array;
+    return has_nulls(array) ? nullptr : values(array);
+  }
+
+  static void* dataptr(SEXP x, Rboolean writeable) {
+    if (!writeable) {
+      const void* out = dataptr_or_null(x);
+      if (out != nullptr) {
+        return const_cast<void*>(out);
+      }
+    }
+    return traits::ptr(materialize(x));
+  }
+
+  static T elt(SEXP x, R_xlen_t i) {
+    SEXP materialized = R_altrep_data2(x);
+    if (materialized != R_NilValue) {
+      return traits::ptr(materialized)[i];
+    }
+    const ArrowArray& array = data(x)->array;
+    return has_nulls(array) && !valid(array, i) ? traits::na() : values(array)[i];
+  }
+
+  static R_xlen_t get_region(SEXP x, R_xlen_t i, R_xlen_t n, T* buf) {
+    n = std::min(n, length(x) - i);
+    if (n <= 0) {
+      return 0;
+    }
+    SEXP materialized = R_altrep_data2(x);
+    if (materialized != R_NilValue) {
+      std::memcpy(buf, traits::ptr(materialized) + i, n * sizeof(T));
+      return n;
+    }
+    const ArrowArray& array = data(x)->array;
+    std::memcpy(buf, values(array) + i, n * sizeof(T));
+    if (has_nulls(array)) {
+      for (R_xlen_t k = 0; k < n; ++k) {
+        if (!valid(array, i + k)) {
+          buf[k] = traits::na();
+        }
+      }
+    }
+    return n;
+  }
+
+ public:
+  static bool& registered() {
+    static bool registered = false;
+    return registered;
+  }
+
+  static void init(DllInfo* dll, const char* package, const char* name) {
+    R_altrep_class_t& cls = altrep_class();
+    cls = traits::make_class(name, package, dll);
+    R_set_altrep_Length_method(cls, length);
+    R_set_altvec_Dataptr_method(cls, dataptr);
+    R_set_altvec_Dataptr_or_null_method(cls, dataptr_or_null);
+    traits::set_methods(cls, elt, get_region);
+    registered() = true;
+  }
+
+  // Takes ownership of `array`
+  static SEXP make(ArrowArray* array) {
+    if (!registered()) {
+      stop("`cpp4r::init_arrow()` must be called before importing Arrow arrays");
+    }
+    external_pointer<arrow_import_data> owner(new arrow_import_data());
+    owner->array = *array;
+    array->release = nullptr;
+
+    ArrowArray& imported = owner->array;
+    owner->length = static_cast<R_xlen_t>(imported.length);
+    if (imported.null_count < 0) {
+      imported.null_count =
+          imported.buffers[0] == nullptr
+              ? 0
+              : arrow_count_nulls(static_cast<const uint8_t*>(imported.buffers[0]),
+                                  imported.offset, imported.length);
+    }
+    return safe[R_new_altrep](altrep_class(), owner, R_NilValue);
+  }
+};
+
+// Releases an Arrow array that was taken over, unless it has been moved out already
+class arrow_array_releaser {
+  ArrowArray* array_;
+
+ public:
+  explicit arrow_array_releaser(ArrowArray* array) : array_(array) {}
+  arrow_array_releaser(const arrow_array_releaser&) = delete;
+  arrow_array_releaser& operator=(const arrow_array_releaser&) = delete;
+
+  ~arrow_array_releaser() {
+    if (array_->release != nullptr) {
+      array_->release(array_);
+      array_->release = nullptr;
+    }
+  }
+};
+
+inline void arrow_check_importable(const ArrowArray* array, const ArrowSchema* schema) {
+  const char* format = schema->format;
+  if (std::strcmp(format, "+s") == 0) {
+    if (array->offset != 0 || (array->null_count != 0 && array->buffers[0] != nullptr)) {
+      stop("Can't import Arrow structs with an offset or null rows");
+    }
+    if (array->n_children != schema->n_children) {
+      stop("Arrow struct has %lld children, but its schema has %lld",
+           static_cast<long long>(array->n_children),
+           static_cast<long long>(schema->n_children));
+    }
+    for (int64_t i = 0; i < array->n_children; ++i) {
+      if (array->children[i]->length < array->length) {
+        stop("Arrow struct has %lld rows, but its child %lld only has %lld",
+             static_cast<long long>(array->length), static_cast<long long>(i + 1),
+             static_cast<long long>(array->children[i]->length));
+      }
+      arrow_check_importable(array->children[i], schema->children[i]);
+    }
+    return;
+  }
+  const bool primitive = std::strcmp(format, "g") == 0 || std::strcmp(format, "i") == 0 ||
+                         std::strcmp(format, "C") == 0;
+  if (!primitive || array->n_buffers != 2 || array->dictionary != nullptr ||
+      (array->length > 0 && array->buffers[1] == nullptr)) {
+    stop("Can't import Arrow arrays of format '%s'", format);
+  }
+}
+
+// Takes ownership of `array`, releasing it if it can't be imported
+inline SEXP arrow_import_array(ArrowArray* array, const ArrowSchema* schema) {
+  arrow_array_releaser releaser(array);
+  const char* format = schema->format;
+  if (std::strcmp(format, "g") == 0) {
+    return arrow_vector<double>::make(array);
+  }
+  if (std::strcmp(format, "i") == 0) {
+    return arrow_vector<int>::make(array);
+  }
+  if (std::strcmp(format, "C") == 0) {
+    return arrow_vector<Rbyte>::make(array);
+  }
+
+  // A struct, whose children are moved out one by one before it is released. Children
+  // longer than the struct are cut to its length.
+  const R_xlen_t n = static_cast<R_xlen_t>(array->n_children);
+  const R_xlen_t nrow = static_cast<R_xlen_t>(array->length);
+  writable::list columns(n);
+  writable::strings names(n);
+  for (R_xlen_t i = 0; i < n; ++i) {
+    const char* name = schema->children[i]->name;
+    names[i] = name == nullptr ? "" : name;
+    ArrowArray* child = array->children[i];
+    if (child->length > array->length) {
+      child->length = array->length;
+      child->null_count = -1;
+    }
+    columns[i] = arrow_import_array(child, schema->children[i]);
+  }
+  columns.names() = names;
+  return writable::data_frame(columns, false, nrow);
+}
+
+}  // namespace detail
+
+// Describes `x`, a double, integer or raw vector or a data frame of them, in `array`
+// and `schema`, without copying it
+inline void export_arrow(SEXP x, ArrowArray* array, ArrowSchema* schema) {
+  ArrowSchema out;
+  detail::arrow_export_schema(x, "", &out);
+  try {
+    detail::arrow_export_array(x, array);
+  } catch (...) {
+    out.release(&out);
+    throw;
+  }
+  *schema = out;
+}
+
+// Takes ownership of `array`, and gives it back as a vector or a data frame. The array
+// is released if it can't be imported. `schema` is left to the caller.
+inline sexp import_arrow(ArrowArray* array, const ArrowSchema* schema) {
+  if (array->release == nullptr) {
+    stop("Can't import an Arrow array that has been released");
+  }
+  try {
+    detail::arrow_check_importable(array, schema);
+  } catch (...) {
+    array->release(array);
+    throw;
+  }
+  return detail::arrow_import_array(array, schema);
+}
+
+// Registers the ALTREP classes of imported arrays for `package`
+inline void init_arrow(DllInfo* dll, const char* package) {
+  detail::arrow_vector<double>::init(dll, package, "cpp4r_arrow_double");
+  detail::arrow_vector<int>::init(dll, package, "cpp4r_arrow_integer");
+  detail::arrow_vector<Rbyte>::init(dll, package, "cpp4r_arrow_raw");
+}
+
+}  // namespace cpp4r
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>   // for size_t, ptrdiff_t
+#include <iterator>  // for input_iterator_tag
+#include <vector>    // for vector
+
+#include "cpp4r/R.hpp"            // for SEXP, R_xlen_t, NA_INTEGER, NA_REAL
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_ALWAYS_INLINE, CPP4R_RESTRICT
+#include "cpp4r/matrix.hpp"       // for detail::row_tile_bytes
+#include "cpp4r/r_vector.hpp"     // for type_error
+#include "cpp4r/sexp.hpp"         // for sexp
+
+// A read-only view of a numeric matrix as doubles that does not copy it up front.
+//
+// A `doubles_matrix<>` argument coerces an integer or logical matrix with
+// `Rf_coerceVector()`, allocating a full double copy before the kernel runs.
+// `coercing_doubles_matrix` keeps the original vector and converts elements as they are
+// read instead: one at a time through `operator()`, or a block of whole columns (about
+// 256KB) at a time through `column_blocks()`, mapping `NA` to `NA_real_`. Double
+// matrices are read in place.
+
+namespace cpp4r {
+
+namespace detail {
+
+// Converts integers or logicals to doubles, with `NA` as `NA_real_`
+inline void int_to_double(const int* CPP4R_RESTRICT in, R_xlen_t n,
+                          double* CPP4R_RESTRICT out) {
+  for (R_xlen_t i = 0; i < n; ++i) {
+    const int value = in[i];
+    out[i] = value == NA_INTEGER ? NA_REAL : static_cast<double>(value);
+  }
+}
+
+}  // namespace detail
+
+class coercing_doubles_matrix {
+  sexp data_;
+  SEXPTYPE type_;
+  R_xlen_t nrow_, ncol_;
+  // Data pointers for ordinary vectors; ALTREP vectors are read by region instead
+  const double* reals_ = nullptr;
+  const int* ints_ = nullptr;
+
+  // Reads `n` elements from `offset` as doubles, into `out` unless they can be read in
+  // place
+  const double* read(R_xlen_t offset, R_xlen_t n, std::vector<double>& out,
+                     std::vector<int>& ints) const {
+    if (reals_ != nullptr) {
+      return reals_ + offset;
+    }
+    out.resize(n);
+    if (ints_ != nullptr) {
+      detail::int_to_double(ints_ + offset, n, out.data());
+    } else if (type_ == REALSXP) {
+      REAL_GET_REGION(data_, offset, n, out.data());
+    } else {
+      ints.resize(n);
+      if (type_ == INTSXP) {
+        INTEGER_GET_REGION(data_, offset, n, ints.data());
+      } else {
+        LOGICAL_GET_REGION(data_, offset, n, ints.data());
+      }
+      detail::int_to_double(ints.data(), n, out.data());
+    }
+    return out.data();
+  }
+
+ public:
+  // Whole columns of the matrix, as contiguous doubles
+  class column_block {
+    const double* data_;
+    int first_col_, ncol_;
+    R_xlen_t nrow_;
+
+   public:
+    column_block(const double* data, int first_col, int ncol, R_xlen_t nrow)
+        : data_(data), first_col_(first_col), ncol_(ncol), nrow_(nrow) {}
+
+    // Column of the matrix that the first column of the block comes from
+    int first_col() const noexcept { return first_col_; }
+    int ncol() const noexcept { return ncol_; }
+    int nrow() const noexcept { return static_cast<int>(nrow_); }
+
+    CPP4R_ALWAYS_INLINE const double* column(int j) const noexcept {
+      return data_ + j * nrow_;
+    }
+    CPP4R_ALWAYS_INLINE double operator()(int i, int j) const noexcept {
+      return column(j)[i];
+    }
+  };
+
+  // Single-pass range over blocks of columns. Converted blocks share one scratch
+  // buffer, so a block is only valid until the iterator moves on.
+  class column_blocks_range {
+    const coercing_doubles_matrix& parent_;
+    int block_cols_;
+    std::vector<double> scratch_;
+    std::vector<int> ints_;
+
+   public:
+    column_blocks_range(const coercing_doubles_matrix& parent, int block_cols)
+        : parent_(parent) {
+      if (block_cols <= 0) {
+        const std::size_t nrow = parent.nrow() > 0 ? parent.nrow() : 1;
+        const std::size_t fit = detail::row_tile_bytes / (sizeof(double) * nrow);
+        block_cols = fit < 1 ? 1 : static_cast<int>(fit);
+      }
+      block_cols_ = block_cols < parent.ncol() ? block_cols : parent.ncol();
+    }
+
+    class iterator {
+      column_blocks_range* range_;
+      int first_col_;
+
+     public:
+      using difference_type = std::ptrdiff_t;
+      using value_type = column_block;
+      using pointer = column_block*;
+      using reference = column_block;
+      using iterator_category = std::input_iterator_tag;
+
+      iterator(column_blocks_range* range, int first_col)
+          : range_(range), first_col_(first_col) {}
+      iterator& operator++() {
+        first_col_ += range_->block_cols_;
+        if (first_col_ > range_->parent_.ncol()) first_col_ = range_->parent_.ncol();
+        return *this;
+      }
+      bool operator==(const iterator& rhs) const { return first_col_ == rhs.first_col_; }
+      bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+      column_block operator*() const {
+        const coercing_doubles_matrix& parent = range_->parent_;
+        const int remaining = parent.ncol() - first_col_;
+        const int block_cols = range_->block_cols_;
+        const int ncol = remaining < block_cols ? remaining : block_cols;
+        const double* data = parent.read(first_col_ * parent.nrow_, ncol * parent.nrow_,
+                                         range_->scratch_, range_->ints_);
+        return {data, first_col_, ncol, parent.nrow_};
+      }
+    };
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, parent_.ncol()}; }
+  };
+
+  coercing_doubles_matrix(SEXP data)
+      : data_(data),
+        type_(detail::r_typeof(data)),
+        nrow_(Rf_nrows(data)),
+        ncol_(Rf_ncols(data)) {
+    if (type_ != REALSXP && type_ != INTSXP && type_ != LGLSXP) {
+      throw type_error(REALSXP, type_);
+    }
+    if (!ALTREP(data)) {
+      if (type_ == REALSXP) {
+        reals_ = REAL(data);
+      } else {
+        ints_ = type_ == INTSXP ? INTEGER(data) : LOGICAL(data);
+      }
+    }
+  }
+
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int nrow() const noexcept {
+    return static_cast<int>(nrow_);
+  }
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int ncol() const noexcept {
+    return static_cast<int>(ncol_);
+  }
+  CPP4R_NODISCARD R_xlen_t size() const noexcept { return nrow_ * ncol_; }
+
+  SEXP data() const { return data_; }
+
+  // Whether the elements are converted from integers or logicals when read
+  bool is_coerced() const noexcept { return type_ != REALSXP; }
+
+  CPP4R_ALWAYS_INLINE double operator()(R_xlen_t row, R_xlen_t col) const {
+    const R_xlen_t pos = row + col * nrow_;
+    if (reals_ != nullptr) {
+      return reals_[pos];
+    }
+    int value;
+    if (ints_ != nullptr) {
+      value = ints_[pos];
+    } else if (type_ == REALSXP) {
+      return REAL_ELT(data_, pos);
+    } else {
+      value = type_ == INTSXP ? INTEGER_ELT(data_, pos) : LOGICAL_ELT(data_, pos);
+    }
+    return value == NA_INTEGER ? NA_REAL : static_cast<double>(value);
+  }
+
+  // Iterates over blocks of `block_cols` columns (by default as many as fit in about
+  // 256KB) converted to doubles
+  column_blocks_range column_blocks(int block_cols = 0) const {
+    return {*this, block_cols};
+  }
+};
+
+}  // namespace cpp4r
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstddef>           // for size_t
+#include <cstring>           // for memcpy, memcmp, strlen
+#include <initializer_list>  // for initializer_list
+#include <string>            // for string
+#include <tuple>             // for tuple, get
+#include <unordered_map>     // for unordered_map
+#include <utility>           // for forward
+#include <vector>            // for vector
+
+#include "cpp4r/R.hpp"            // for SEXP, R_xlen_t, REAL, INTEGER, LOGICAL
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_UNLIKELY, CPP4R_HAS_CXX17
+#include "cpp4r/data_frame.hpp"   // for writable::data_frame
+#include "cpp4r/list.hpp"         // for writable::list
+#include "cpp4r/protect.hpp"      // for safe, stop, detail::store
+#include "cpp4r/r_bool.hpp"       // for r_bool
+#include "cpp4r/r_string.hpp"     // for r_string, string_view
+#include "cpp4r/strings.hpp"      // for writable::strings
+
+// Builds a data frame one row at a time.
+//
+// `data_frame_builder<T...>` owns one R vector per column (`double`, `int`, `r_bool` or
+// `r_string`), all with the same capacity, so `push_back(values...)` checks for room
+// once per row and writes each value straight into its column. When the rows run out,
+// every column grows together (doubling); `reserve()` sets the capacity of all of them
+// at once. String columns remember the CHARSXPs they have made, so repeated values skip
+// `Rf_mkCharLenCE()`.
+//
+// `finish()` puts the columns in a list with compact row names and the `data.frame`
+// class. A column is only copied there if it has spare capacity, so reserving the exact
+// number of rows up front avoids any copy at all.
+
+namespace cpp4r {
+
+namespace detail {
+
+// Rows of the first allocation when nothing was reserved
+constexpr R_xlen_t builder_initial_rows = 1024;
+
+// Distinct strings remembered per string column
+constexpr std::size_t builder_string_cache_size = 1 << 16;
+
+template <typename T>
+struct builder_traits;
+
+template <>
+struct builder_traits<double> {
+  using underlying_type = double;
+  static constexpr SEXPTYPE sexptype = REALSXP;
+  static double* ptr(SEXP x) { return REAL(x); }
+  static double store(double value) { return value; }
+};
+
+template <>
+struct builder_traits<int> {
+  using underlying_type = int;
+  static constexpr SEXPTYPE sexptype = INTSXP;
+  static int* ptr(SEXP x) { return INTEGER(x); }
+  static int store(int value) { return value; }
+};
+
+template <>
+struct builder_traits<r_bool> {
+  using underlying_type = int;
+  static constexpr SEXPTYPE sexptype = LGLSXP;
+  static int* ptr(SEXP x) { return LOGICAL(x); }
+  static int store(r_bool value) { return static_cast<int>(value); }
+};
+
+// An R vector and its protection, replaced by a larger (or exact) copy when resized
+class builder_vector {
+ protected:
+  SEXP data_ = R_NilValue;
+  SEXP protect_ = R_NilValue;
+
+  void replace(SEXP data) {
+    SEXP old_protect = protect_;
+    data_ = data;
+    protect_ = store::insert(data_);
+    store::release(old_protect);
+  }
+
+  void release() {
+    store::release(protect_);
+    data_ = R_NilValue;
+    protect_ = R_NilValue;
+  }
+
+ public:
+  builder_vector() = default;
+  builder_vector(const builder_vector&) = delete;
+  builder_vector& operator=(const builder_vector&) = delete;
+  ~builder_vector() { store::release(protect_); }
+};
+
+template <typename T>
+class builder_column : public builder_vector {
+  using traits = builder_traits<T>;
+  typename traits::underlying_type* p_ = nullptr;
+
+ public:
+  void reserve(R_xlen_t nrow, R_xlen_t capacity) {
+    const SEXPTYPE type = traits::sexptype;
+    SEXP out = safe[Rf_allocVector](type, capacity);
+    typename traits::underlying_type* p = traits::ptr(out);
+    if (nrow > 0) {
+      std::memcpy(p, p_, nrow * sizeof(typename traits::underlying_type));
+    }
+    replace(out);
+    p_ = p;
+  }
+
+  CPP4R_ALWAYS_INLINE void set(R_xlen_t i, T value) { p_[i] = traits::store(value); }
+
+  SEXP finish(R_xlen_t nrow) {
+    if (data_ == R_NilValue || Rf_xlength(data_) != nrow) {
+      reserve(nrow, nrow);
+    }
+    return data_;
+  }
+
+  void clear() {
+    release();
+    p_ = nullptr;
+  }
+};
+
+template <>
+class builder_column<r_string> : public builder_vector {
+  std::unordered_map<std::string, SEXP> cache_;
+  std::string last_;
+  SEXP last_elt_ = R_NilValue;
+
+  // The CHARSXP for `str`, shared with the previous rows where possible. Cached
+  // CHARSXPs are all in the column, which keeps them alive.
+  SEXP intern(const char* str, std::size_t size) {
+    if (last_elt_ != R_NilValue && size == last_.size() &&
+        std::memcmp(str, last_.data(), size) == 0) {
+      return last_elt_;
+    }
+    last_.assign(str, size);
+    auto it = cache_.find(last_);
+    if (it != cache_.end()) {
+      last_elt_ = it->second;
+      return last_elt_;
+    }
+    last_elt_ = safe[Rf_mkCharLenCE](str, static_cast<int>(size), CE_UTF8);
+    if (cache_.size() < builder_string_cache_size) {
+      cache_.emplace(last_, last_elt_);
+    }
+    return last_elt_;
+  }
+
+ public:
+  void reserve(R_xlen_t nrow, R_xlen_t capacity) {
+    SEXP out = PROTECT(safe[Rf_allocVector](STRSXP, capacity));
+    for (R_xlen_t i = 0; i < nrow; ++i) {
+      SET_STRING_ELT(out, i, STRING_ELT(data_, i));
+    }
+    replace(out);
+    UNPROTECT(1);
+  }
+
+  void set(R_xlen_t i, const char* value) {
+    SET_STRING_ELT(data_, i, intern(value, std::strlen(value)));
+  }
+  void set(R_xlen_t i, const std::string& value) {
+    SET_STRING_ELT(data_, i, intern(value.data(), value.size()));
+  }
+#if CPP4R_HAS_CXX17
+  void set(R_xlen_t i, std::string_view value) {
+    SET_STRING_ELT(data_, i, intern(value.data(), value.size()));
+  }
+#endif
+  // Also takes `NA_STRING` and `na<r_string>()`
+  void set(R_xlen_t i, const r_string& value) { SET_STRING_ELT(data_, i, value); }
+
+  SEXP finish(R_xlen_t nrow) {
+    if (data_ == R_NilValue || Rf_xlength(data_) != nrow) {
+      reserve(nrow, nrow);
+    }
+    return data_;
+  }
+
+  void clear() {
+    release();
+    cache_.clear();
+    last_.clear();
+    last_elt_ = R_NilValue;
+  }
+};
+
+}  // namespace detail
+
+template <typename... T>
+class data_frame_builder {
+  std::vector<std::string> names_;
+  std::tuple<detail::builder_column<T>...> columns_;
+  R_xlen_t nrow_ = 0;
+  R_xlen_t capacity_ = 0;
+
+  template <std::size_t... I>
+  void reserve_columns(R_xlen_t capacity, detail::index_sequence<I...>) {
+    const int unused[] = {0, (std::get<I>(columns_).reserve(nrow_, capacity), 0)...};
+    (void)unused;
+  }
+
+  template <typename... A, std::size_t... I>
+  void set_row(detail::index_sequence<I...>, A&&... values) {
+    const int unused[] = {
+        0, (std::get<I>(columns_).set(nrow_, std::forward<A>(values)), 0)...};
+    (void)unused;
+  }
+
+  template <std::size_t... I>
+  void finish_columns(writable::list& out, detail::index_sequence<I...>) {
+    const int unused[] = {
+        0, (SET_VECTOR_ELT(out, I, std::get<I>(columns_).finish(nrow_)), 0)...};
+    (void)unused;
+  }
+
+  template <std::size_t... I>
+  void clear_columns(detail::index_sequence<I...>) {
+    const int unused[] = {0, (std::get<I>(columns_).clear(), 0)...};
+    (void)unused;
+  }
+
+ public:
+  // A builder for columns called `names`, with room for `capacity` rows
+  explicit data_frame_builder(std::initializer_list<std::string> names,
+                              R_xlen_t capacity = 0)
+      : names_(names) {
+    if (names_.size() != sizeof...(T)) {
+      stop("A data frame builder of %d columns needs %d names, not %d",
+           static_cast<int>(sizeof...(T)), static_cast<int>(sizeof...(T)),
+           static_cast<int>(names_.size()));
+    }
+    if (capacity > 0) {
+      reserve(capacity);
+    }
+  }
+
+  R_xlen_t nrow() const noexcept { return nrow_; }
+  R_xlen_t capacity() const noexcept { return capacity_; }
+
+  // Makes room for `capacity` rows in every column
+  void reserve(R_xlen_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    reserve_columns(capacity, detail::make_index_sequence<sizeof...(T)>{});
+    capacity_ = capacity;
+  }
+
+  // Appends a row, with one value per column
+  template <typename... A>
+  void push_back(A&&... values) {
+    static_assert(sizeof...(A) == sizeof...(T), "A row takes one value per column");
+    if (CPP4R_UNLIKELY(nrow_ == capacity_)) {
+      reserve(capacity_ == 0 ? detail::builder_initial_rows : capacity_ * 2);
+    }
+    set_row(detail::make_index_sequence<sizeof...(T)>{}, std::forward<A>(values)...);
+    ++nrow_;
+  }
+
+  // The data frame of the rows so far. The builder is left empty.
+  writable::data_frame finish() {
+    writable::list out(static_cast<R_xlen_t>(sizeof...(T)));
+    finish_columns(out, detail::make_index_sequence<sizeof...(T)>{});
+
+    writable::strings names(static_cast<R_xlen_t>(sizeof...(T)));
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+      names[static_cast<R_xlen_t>(i)] = names_[i];
+    }
+    out.names() = names;
+
+    const R_xlen_t nrow = nrow_;
+    clear_columns(detail::make_index_sequence<sizeof...(T)>{});
+    nrow_ = 0;
+    capacity_ = 0;
+    return writable::data_frame(out, false, nrow);
+  }
+};
+
+}  // namespace cpp4r
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstring>      // for strcmp
+#include <iterator>     // for forward_iterator_tag
+#include <tuple>        // for tuple, get, tuple_element
+#include <type_traits>  // for integral_constant
+
+#include "cpp4r/R.hpp"            // for SEXP, R_xlen_t
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_HAS_CXX20
+#include "cpp4r/data_frame.hpp"   // for data_frame
+#include "cpp4r/matrix.hpp"       // for detail::get_sexptype_v
+#include "cpp4r/protect.hpp"      // for stop, detail::index_sequence, fixed_string
+#include "cpp4r/r_vector.hpp"     // for r_vector
+
+// A data frame with a schema known at compile time.
+//
+// `data_frame_of<Cols...>` looks up, type-checks and length-checks every column of the
+// schema once, when it is constructed, and keeps each one as a typed `r_vector<T>` with
+// its data pointer cached, plus the number of rows. Columns are then read by position
+// (`column<0>()`) or, from C++20, by name (`column<"x">()`), and `row(i)` / `rows()`
+// give the values of a row as a `std::tuple`, which can be unpacked with structured
+// bindings, without looking anything up again. Strings are given as their CHARSXP
+// (a `SEXP`), so reading a row never touches the protection list.
+//
+// Each column is described by a type with a `type` (`double`, `int`, `r_bool`,
+// `r_complex` or `r_string`) and a static `name()`. With C++20, `col<"x", double>` is
+// one; before that, derive from `column_spec`:
+//
+//   struct x_col : cpp4r::column_spec<double> {
+//     static const char* name() { return "x"; }
+//   };
+
+namespace cpp4r {
+
+template <typename T>
+struct column_spec {
+  using type = T;
+};
+
+#if CPP4R_HAS_CXX20
+namespace detail {
+
+constexpr bool same_name(const char* a, const char* b) {
+  while (*a != '\0' && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return *a == *b;
+}
+
+}  // namespace detail
+
+template <detail::fixed_string Name, typename T>
+struct col : column_spec<T> {
+  static constexpr const char* name() { return Name.value; }
+};
+#endif
+
+namespace detail {
+
+// The type of a column's values in a row: strings are read as their CHARSXP
+template <typename T>
+struct row_element {
+  using type = T;
+  static T get(const r_vector<T>& column, R_xlen_t i) { return column[i]; }
+};
+
+template <>
+struct row_element<r_string> {
+  using type = SEXP;
+  static SEXP get(const r_vector<r_string>& column, R_xlen_t i) {
+    return STRING_ELT(column.data(), i);
+  }
+};
+
+}  // namespace detail
+
+template <typename... Cols>
+class data_frame_of {
+ public:
+  using row_type = std::tuple<typename detail::row_element<typename Cols::type>::type...>;
+
+  template <std::size_t I>
+  using column_type = r_vector<
+      typename std::tuple_element<I, std::tuple<typename Cols::type...>>::type>;
+
+ private:
+  data_frame data_;
+  R_xlen_t nrow_;
+  std::tuple<r_vector<typename Cols::type>...> columns_;
+
+  template <typename Col>
+  static SEXP find_column(SEXP data, R_xlen_t nrow) {
+    const char* name = Col::name();
+    SEXP names = Rf_getAttrib(data, R_NamesSymbol);
+    const R_xlen_t n = Rf_xlength(data);
+    for (R_xlen_t i = 0; names != R_NilValue && i < n; ++i) {
+      if (std::strcmp(CHAR(STRING_ELT(names, i)), name) != 0) {
+        continue;
+      }
+      SEXP column = VECTOR_ELT(data, i);
+      const SEXPTYPE expected = detail::get_sexptype_v<typename Col::type>::value;
+      const SEXPTYPE actual = detail::r_typeof(column);
+      if (actual != expected) {
+        stop("Column '%s' must be of type '%s', not '%s'", name, Rf_type2char(expected),
+             Rf_type2char(actual));
+      }
+      if (Rf_xlength(column) != nrow) {
+        stop("Column '%s' has %lld rows, expected %lld", name,
+             static_cast<long long>(Rf_xlength(column)), static_cast<long long>(nrow));
+      }
+      return column;
+    }
+    stop("Column '%s' is missing", name);
+  }
+
+  template <std::size_t... I>
+  row_type make_row(R_xlen_t i, detail::index_sequence<I...>) const {
+    return row_type(
+        detail::row_element<typename Cols::type>::get(std::get<I>(columns_), i)...);
+  }
+
+ public:
+  class row_iterator {
+    const data_frame_of* parent_;
+    R_xlen_t pos_;
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = row_type;
+    using pointer = row_type*;
+    using reference = row_type;
+    using iterator_category = std::forward_iterator_tag;
+
+    row_iterator(const data_frame_of* parent, R_xlen_t pos)
+        : parent_(parent), pos_(pos) {}
+    row_iterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+    bool operator==(const row_iterator& rhs) const { return pos_ == rhs.pos_; }
+    bool operator!=(const row_iterator& rhs) const { return !(*this == rhs); }
+    row_type operator*() const { return parent_->row(pos_); }
+  };
+
+  class rows_range {
+    const data_frame_of* parent_;
+
+   public:
+    explicit rows_range(const data_frame_of* parent) : parent_(parent) {}
+    row_iterator begin() const { return {parent_, 0}; }
+    row_iterator end() const { return {parent_, parent_->nrow()}; }
+  };
+
+  data_frame_of(SEXP data)
+      : data_(data),
+        nrow_(data_.nrow()),
+        columns_(r_vector<typename Cols::type>(find_column<Cols>(data_, nrow_))...) {}
+
+  CPP4R_NODISCARD R_xlen_t nrow() const noexcept { return nrow_; }
+  CPP4R_NODISCARD static constexpr R_xlen_t ncol() noexcept { return sizeof...(Cols); }
+
+  SEXP data() const { return data_; }
+  operator SEXP() const { return data_; }
+
+  // Column `I` of the schema
+  template <std::size_t I>
+  const column_type<I>& column() const noexcept {
+    return std::get<I>(columns_);
+  }
+
+#if CPP4R_HAS_CXX20
+ private:
+  template <detail::fixed_string Name>
+  static constexpr std::size_t index_of() {
+    constexpr const char* names[] = {Cols::name()...};
+    for (std::size_t i = 0; i < sizeof...(Cols); ++i) {
+      if (detail::same_name(names[i], Name.value)) return i;
+    }
+    return sizeof...(Cols);
+  }
+
+ public:
+  // The column called `Name`, found at compile time
+  template <detail::fixed_string Name>
+  const auto& column() const noexcept {
+    constexpr std::size_t i = index_of<Name>();
+    static_assert(i < sizeof...(Cols), "No column of that name in the schema");
+    return std::get<i>(columns_);
+  }
+#endif
+
+  // The values of row `i`, one per column of the schema
+  row_type row(R_xlen_t i) const {
+    return make_row(i, detail::make_index_sequence<sizeof...(Cols)>{});
+  }
+
+  rows_range rows() const { return rows_range(this); }
+};
+
+}  // namespace cpp4r
@@ -1,6 +1,9 @@
 #pragma once
 
-#include <string>  // for string, basic_string
+#include <cstddef>   // for ptrdiff_t
+#include <iterator>  // for forward_iterator_tag
+#include <string>    // for string, basic_string
+#include <utility>   // for move
 
 // C++17+: std::string_view for zero-cost string argument passing
 #if CPP4R_HAS_CXX17
@@ -11,6 +14,16 @@
 #include "cpp4r/as.hpp"       // for as_sexp
 #include "cpp4r/protect.hpp"  // for safe, protect, etc.
 #include "cpp4r/sexp.hpp"     // for sexp
+#include "cpp4r/symbol.hpp"   // for symbol
+
+// Bindings are read and written in bulk as well as one at a time.
+//
+// `bindings()` iterates over the frame of an environment, hashed or not, as
+// (symbol, value) pairs. The names are listed once, unsorted, and each value is looked
+// up as the iterator reaches it, so nothing is copied and no R-level `ls()` or `get()`
+// is called. `get_many()` and `assign_many()` read or write a whole character vector
+// of names inside a single unwind region, rather than one `safe[]` call per name, which
+// is what matters for environments used as caches with many thousands of entries.
 
 namespace cpp4r {
 
@@ -18,6 +31,19 @@ class environment {
  private:
   sexp env_;
 
+  static void check_names(SEXP names) {
+    if (TYPEOF(names) != STRSXP) {
+      stop("`names` must be a character vector, not a '%s'", Rf_type2char(TYPEOF(names)));
+    }
+    const R_xlen_t n = Rf_xlength(names);
+    for (R_xlen_t i = 0; i < n; ++i) {
+      SEXP name = STRING_ELT(names, i);
+      if (name == NA_STRING || CHAR(name)[0] == '\0') {
+        stop("`names` can't contain missing or empty names");
+      }
+    }
+  }
+
   class proxy {
     SEXP parent_;
     SEXP name_;
@@ -35,6 +61,54 @@ class environment {
   };
 
  public:
+  // A binding of the environment. `value` is kept alive by the binding itself, so it is
+  // only valid until the binding is reassigned or removed.
+  struct binding {
+    SEXP name;
+    SEXP value;
+  };
+
+  class binding_iterator {
+    SEXP env_;
+    SEXP names_;
+    R_xlen_t pos_;
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = binding;
+    using pointer = binding*;
+    using reference = binding;
+    using iterator_category = std::forward_iterator_tag;
+
+    binding_iterator(SEXP env, SEXP names, R_xlen_t pos)
+        : env_(env), names_(names), pos_(pos) {}
+    binding_iterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+    bool operator==(const binding_iterator& rhs) const { return pos_ == rhs.pos_; }
+    bool operator!=(const binding_iterator& rhs) const { return !(*this == rhs); }
+    binding operator*() const {
+      SEXP name = safe[Rf_installChar](STRING_ELT(names_, pos_));
+      return {name, safe[detail::r_env_get](env_, name)};
+    }
+  };
+
+  // The bindings of an environment when `bindings()` was called. Removing a binding while
+  // iterating makes dereferencing it an error.
+  class bindings_range {
+    SEXP env_;
+    sexp names_;
+
+   public:
+    bindings_range(SEXP env, sexp names) : env_(env), names_(std::move(names)) {}
+    binding_iterator begin() const { return {env_, names_, 0}; }
+    binding_iterator end() const { return {env_, names_, size()}; }
+    R_xlen_t size() const noexcept { return Rf_xlength(names_); }
+    // The names of the bindings, as a STRSXP
+    SEXP names() const noexcept { return names_; }
+  };
+
   environment(SEXP env) : env_(env) {}
   environment(sexp env) : env_(env) {}
 
@@ -52,6 +126,7 @@ class environment {
   static environment base_env() noexcept { return environment(R_BaseEnv); }
   static environment empty_env() noexcept { return environment(R_EmptyEnv); }
 
+  // A `symbol` (or `"x"_sym`) skips installing the name on every lookup
   proxy operator[](const SEXP name) const { return {env_, name}; }
   proxy operator[](const char* name) const { return operator[](safe[Rf_install](name)); }
   proxy operator[](const std::string& name) const { return operator[](name.c_str()); }
@@ -98,6 +173,62 @@ class environment {
 
   R_xlen_t size() const noexcept { return Rf_xlength(env_); }
 
+  // Iterate over the bindings of this environment (not its enclosures), in no particular
+  // order. Pass all_names = false to skip names beginning with '.'.
+  bindings_range bindings(bool all_names = true) const {
+    return {env_, safe[R_lsInternal3](env_, all_names ? TRUE : FALSE, FALSE)};
+  }
+
+  // The values bound to `names` (a character vector), as a list named by `names`. A name
+  // without a binding is an error, unless `if_missing` is given to use in its place.
+  sexp get_many(SEXP names, SEXP if_missing = R_UnboundValue) const {
+    check_names(names);
+    SEXP env = env_;
+    return unwind_protect([&] {
+      const R_xlen_t n = Rf_xlength(names);
+      SEXP out = PROTECT(Rf_allocVector(VECSXP, n));
+      for (R_xlen_t i = 0; i < n; ++i) {
+        SEXP name = Rf_installChar(STRING_ELT(names, i));
+        SEXP value = if_missing == R_UnboundValue
+                         ? detail::r_env_get(env, name)
+                         : detail::r_env_get_or(env, name, if_missing);
+        SET_VECTOR_ELT(out, i, value);
+      }
+      Rf_setAttrib(out, R_NamesSymbol, names);
+      UNPROTECT(1);
+      return out;
+    });
+  }
+
+  // Binds each of `names` (a character vector) to the matching element of `values` (a
+  // list of the same length)
+  void assign_many(SEXP names, SEXP values) {
+    check_names(names);
+    if (TYPEOF(values) != VECSXP) {
+      stop("`values` must be a list, not a '%s'", Rf_type2char(TYPEOF(values)));
+    }
+    const R_xlen_t n = Rf_xlength(names);
+    if (Rf_xlength(values) != n) {
+      stop("`values` has %lld elements, expected %lld",
+           static_cast<long long>(Rf_xlength(values)), static_cast<long long>(n));
+    }
+    SEXP env = env_;
+    unwind_protect([&] {
+      for (R_xlen_t i = 0; i < n; ++i) {
+        Rf_defineVar(Rf_installChar(STRING_ELT(names, i)), VECTOR_ELT(values, i), env);
+      }
+    });
+  }
+
+  // Binds every element of the named list `values` to its name
+  void assign_many(SEXP values) {
+    sexp names(Rf_getAttrib(values, R_NamesSymbol));
+    if (names == R_NilValue) {
+      stop("`values` must be a named list");
+    }
+    assign_many(names, values);
+  }
+
   operator SEXP() const noexcept { return env_; }
 };
 
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <climits>  // for INT_MAX
+#include <cstdint>  // for uint64_t
+#include <vector>   // for vector
+
+#include "cpp4r/R.hpp"            // for R_xlen_t, NA_INTEGER, ISNAN
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_PREFETCH, CPP4R_LIKELY
+#include "cpp4r/doubles.hpp"      // for doubles
+#include "cpp4r/integers.hpp"     // for integers
+#include "cpp4r/protect.hpp"      // for stop
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Batched `base::findInterval()`.
+//
+// For every `x[j]` the result is the number of breaks `v` with `v[i] <= x[j]` (or
+// `v[i] < x[j]` when `left_open = true`), adjusted at the boundaries by
+// `rightmost_closed` and `all_inside` exactly like R does. `NA` and `NaN` give `NA`.
+//
+// Three search strategies are used, picked per call:
+//
+//  - non-decreasing queries walk the breaks once, galloping from the previous answer, so
+//    a sorted `x` costs O(m log(n / m)) and never touches the breaks out of order;
+//  - few queries against many breaks use a branch-free binary search on `v` itself;
+//  - otherwise the breaks are copied once into an Eytzinger (BFS) layout, whose top
+//    levels stay in cache and whose descent has no unpredictable branch.
+//
+// `interval_finder` keeps the layout between calls when the same breaks are searched
+// repeatedly. Long query vectors are split across OpenMP threads.
+
+namespace cpp4r {
+
+struct find_interval_options {
+  // Like `rightmost.closed`: the last interval is closed on the right (or, with
+  // `left_open`, the first interval is closed on the left)
+  bool rightmost_closed = false;
+  // Like `all.inside`: map 0 to 1 and `length(breaks)` to `length(breaks) - 1`
+  bool all_inside = false;
+  // Like `left.open`: intervals are open on the left and closed on the right
+  bool left_open = false;
+  // Split long query vectors across OpenMP threads (when compiled with OpenMP)
+  bool parallel = true;
+};
+
+namespace detail {
+namespace interval {
+
+// Queries above this size may run in parallel
+constexpr R_xlen_t parallel_threshold = R_xlen_t(1) << 16;
+
+// Below this many queries per break, searching `v` directly beats building the layout
+constexpr R_xlen_t layout_ratio = 16;
+
+inline int threads_for(R_xlen_t m, bool parallel) {
+#ifdef _OPENMP
+  if (parallel && m >= parallel_threshold) {
+    return omp_get_max_threads();
+  }
+#endif
+  (void)m;
+  (void)parallel;
+  return 1;
+}
+
+// Number of trailing one bits of `k`
+inline int trailing_ones(uint64_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(~k);
+#else
+  int out = 0;
+  while (k & 1) {
+    k >>= 1;
+    ++out;
+  }
+  return out;
+#endif
+}
+
+// `v <= x`, or `v < x` for left-open intervals
+template <bool LeftOpen>
+inline bool before(double v, double x) {
+  return LeftOpen ? v < x : v <= x;
+}
+
+// Number of leading elements of sorted `v[0, n)` that come before `x`, without a
+// data-dependent branch
+template <bool LeftOpen>
+inline R_xlen_t count_before(const double* v, R_xlen_t n, double x) {
+  if (n == 0) {
+    return 0;
+  }
+  const double* base = v;
+  R_xlen_t len = n;
+  while (len > 1) {
+    const R_xlen_t half = len / 2;
+    base += before<LeftOpen>(base[half - 1], x) ? half : 0;
+    len -= half;
+  }
+  return (base - v) + before<LeftOpen>(*base, x);
+}
+
+// Like `count_before()`, for `x` no smaller than the previous query, whose answer was
+// `from`: gallop forward from there, then bisect the last step
+template <bool LeftOpen>
+inline R_xlen_t count_before_from(const double* v, R_xlen_t n, double x, R_xlen_t from) {
+  R_xlen_t lo = from;
+  R_xlen_t hi = from;
+  R_xlen_t step = 1;
+  while (hi < n && before<LeftOpen>(v[hi], x)) {
+    lo = hi + 1;
+    hi += step;
+    step <<= 1;
+  }
+  if (hi > n) {
+    hi = n;
+  }
+  return lo + count_before<LeftOpen>(v + lo, hi - lo, x);
+}
+
+inline int adjust(R_xlen_t r, double x, const double* v, R_xlen_t n,
+                  const find_interval_options& options) {
+  if (r == n) {
+    if (options.all_inside ||
+        (options.rightmost_closed && !options.left_open && x == v[n - 1])) {
+      return static_cast<int>(n - 1);
+    }
+    return static_cast<int>(n);
+  }
+  if (r == 0) {
+    if (options.all_inside ||
+        (options.rightmost_closed && options.left_open && x == v[0])) {
+      return 1;
+    }
+    return 0;
+  }
+  return static_cast<int>(r);
+}
+
+inline bool is_sorted(const double* x, R_xlen_t m) {
+  double last = R_NegInf;
+  for (R_xlen_t j = 0; j < m; ++j) {
+    const double xj = x[j];
+    if (ISNAN(xj)) {
+      continue;
+    }
+    if (xj < last) {
+      return false;
+    }
+    last = xj;
+  }
+  return true;
+}
+
+}  // namespace interval
+}  // namespace detail
+
+class interval_finder {
+ public:
+  // Validates `breaks` like `findInterval()`; the search layout is built on first use
+  explicit interval_finder(const doubles& breaks)
+      : breaks_(breaks), v_(REAL(breaks_.data())), n_(breaks_.size()) {
+    if (n_ >= INT_MAX) {
+      stop("'vec' is too long");
+    }
+    for (R_xlen_t i = 0; i < n_; ++i) {
+      if (ISNAN(v_[i])) {
+        stop("'vec' contains NAs");
+      }
+      if (i > 0 && v_[i] < v_[i - 1]) {
+        stop("'vec' must be sorted non-decreasingly");
+      }
+    }
+  }
+
+  // The interval index of every value of `x`, as `findInterval(x, breaks, ...)`
+  writable::integers operator()(const doubles& x,
+                                const find_interval_options& options =
+                                    find_interval_options()) {
+    const R_xlen_t m = x.size();
+    writable::integers out(m);
+    if (m == 0) {
+      return out;
+    }
+
+    const double* px = REAL(x.data());
+    int* pout = INTEGER(out.data());
+
+    strategy how;
+    if (n_ == 0) {
+      how = strategy::empty;
+    } else if (detail::interval::is_sorted(px, m)) {
+      how = strategy::merge;
+    } else if (m < n_ / detail::interval::layout_ratio && eytzinger_.empty()) {
+      how = strategy::bisect;
+    } else {
+      build_layout();
+      how = strategy::layout;
+    }
+
+    if (options.left_open) {
+      run<true>(how, px, m, pout, options);
+    } else {
+      run<false>(how, px, m, pout, options);
+    }
+    return out;
+  }
+
+ private:
+  enum class strategy { empty, merge, bisect, layout };
+
+  doubles breaks_;
+  const double* v_;
+  R_xlen_t n_;
+
+  // 1-based BFS order of the breaks and the sorted position of each slot
+  std::vector<double> eytzinger_;
+  std::vector<int> position_;
+
+  void build_layout() {
+    if (!eytzinger_.empty()) {
+      return;
+    }
+    eytzinger_.resize(n_ + 1);
+    position_.resize(n_ + 1);
+    fill_layout(0, 1);
+  }
+
+  // In-order walk of the implicit tree, assigning sorted breaks to slots
+  R_xlen_t fill_layout(R_xlen_t i, uint64_t k) {
+    if (k <= static_cast<uint64_t>(n_)) {
+      i = fill_layout(i, 2 * k);
+      eytzinger_[k] = v_[i];
+      position_[k] = static_cast<int>(i);
+      ++i;
+      i = fill_layout(i, 2 * k + 1);
+    }
+    return i;
+  }
+
+  template <bool LeftOpen>
+  R_xlen_t search_layout(double x) const {
+    const double* b = eytzinger_.data();
+    const uint64_t n = static_cast<uint64_t>(n_);
+    uint64_t k = 1;
+    while (k <= n) {
+      // The 16 descendants four levels down share two cache lines
+      if (16 * k <= n) {
+        CPP4R_PREFETCH(b + 16 * k);
+      }
+      k = 2 * k + detail::interval::before<LeftOpen>(b[k], x);
+    }
+    // Undo the trailing right turns (and the final left one) to find the first break
+    // that is not before `x`; `k == 0` means there is none
+    k >>= detail::interval::trailing_ones(k) + 1;
+    return k == 0 ? n_ : position_[k];
+  }
+
+  template <bool LeftOpen>
+  void run_chunk(strategy how, const double* px, R_xlen_t begin, R_xlen_t end, int* pout,
+                 const find_interval_options& options) const {
+    switch (how) {
+      case strategy::empty:
+        for (R_xlen_t j = begin; j < end; ++j) {
+          pout[j] = ISNAN(px[j]) ? NA_INTEGER : 0;
+        }
+        break;
+      case strategy::merge: {
+        R_xlen_t from = 0;
+        for (R_xlen_t j = begin; j < end; ++j) {
+          const double x = px[j];
+          if (ISNAN(x)) {
+            pout[j] = NA_INTEGER;
+            continue;
+          }
+          from = detail::interval::count_before_from<LeftOpen>(v_, n_, x, from);
+          pout[j] = detail::interval::adjust(from, x, v_, n_, options);
+        }
+        break;
+      }
+      case strategy::bisect:
+        for (R_xlen_t j = begin; j < end; ++j) {
+          const double x = px[j];
+          pout[j] = ISNAN(x) ? NA_INTEGER
+                             : detail::interval::adjust(
+                                   detail::interval::count_before<LeftOpen>(v_, n_, x),
+                                   x, v_, n_, options);
+        }
+        break;
+      case strategy::layout:
+        for (R_xlen_t j = begin; j < end; ++j) {
+          const double x = px[j];
+          pout[j] = ISNAN(x) ? NA_INTEGER
+                             : detail::interval::adjust(search_layout<LeftOpen>(x), x,
+                                                        v_, n_, options);
+        }
+        break;
+    }
+  }
+
+  template <bool LeftOpen>
+  void run(strategy how, const double* px, R_xlen_t m, int* pout,
+           const find_interval_options& options) const {
+    const int nthreads = detail::interval::threads_for(m, options.parallel);
+    if (nthreads == 1) {
+      run_chunk<LeftOpen>(how, px, 0, m, pout, options);
+      return;
+    }
+#ifdef _OPENMP
+    // No R API in here: every chunk only reads the breaks and writes its own slice
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (int t = 0; t < nthreads; ++t) {
+      const R_xlen_t begin = m * t / nthreads;
+      const R_xlen_t end = m * (t + 1) / nthreads;
+      run_chunk<LeftOpen>(how, px, begin, end, pout, options);
+    }
+#endif
+  }
+};
+
+// `findInterval(x, breaks, rightmost.closed, all.inside, left.open)`
+inline writable::integers find_interval(
+    const doubles& x, const doubles& breaks,
+    const find_interval_options& options = find_interval_options()) {
+  interval_finder finder(breaks);
+  return finder(x, options);
+}
+
+}  // namespace cpp4r
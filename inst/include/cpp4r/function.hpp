@@ -2,15 +2,18 @@
 
 #include <cstring>  // for std::strcmp (@pachadotdev use std qualifiers)
 
-#include <cstdio>   // for snprintf
-#include <string>   // for string, basic_string
-#include <utility>  // for forward
+#include <cstdio>            // for snprintf
+#include <initializer_list>  // for initializer_list
+#include <string>            // for string, basic_string
+#include <utility>           // for forward
+#include <vector>            // for vector
 
 #include "cpp4r/R.hpp"          // for R’s C interface (e.g., for SEXP)
 #include "cpp4r/as.hpp"         // for as_sexp
 #include "cpp4r/named_arg.hpp"  // for named_arg
 #include "cpp4r/protect.hpp"    // for safe, protect, etc.
 #include "cpp4r/sexp.hpp"       // for sexp
+#include "cpp4r/symbol.hpp"     // for symbol
 
 namespace cpp4r {
 
@@ -27,6 +30,80 @@ struct call_result {
   explicit operator bool() const noexcept { return !error; }
 };
 
+namespace detail {
+
+// `n` elements of `x` from `start`, with the attributes that describe the values
+inline SEXP slice(SEXP x, R_xlen_t start, R_xlen_t n) {
+  const SEXPTYPE type = TYPEOF(x);
+  sexp out = safe[Rf_allocVector](type, n);
+  switch (type) {
+    case REALSXP:
+      if (n > 0) std::memcpy(REAL(out), REAL_RO(x) + start, n * sizeof(double));
+      break;
+    case INTSXP:
+      if (n > 0) std::memcpy(INTEGER(out), INTEGER_RO(x) + start, n * sizeof(int));
+      break;
+    case LGLSXP:
+      if (n > 0) std::memcpy(LOGICAL(out), LOGICAL_RO(x) + start, n * sizeof(int));
+      break;
+    case CPLXSXP:
+      if (n > 0) std::memcpy(COMPLEX(out), COMPLEX_RO(x) + start, n * sizeof(Rcomplex));
+      break;
+    case RAWSXP:
+      if (n > 0) std::memcpy(RAW(out), RAW_RO(x) + start, n);
+      break;
+    case STRSXP:
+      for (R_xlen_t i = 0; i < n; ++i) SET_STRING_ELT(out, i, STRING_ELT(x, start + i));
+      break;
+    case VECSXP:
+      for (R_xlen_t i = 0; i < n; ++i) SET_VECTOR_ELT(out, i, VECTOR_ELT(x, start + i));
+      break;
+    default:
+      stop("Can't split a '%s' into batches", Rf_type2char(type));
+  }
+  Rf_copyMostAttrib(x, out);
+  return out;
+}
+
+// Copies `part` into `out` from `start`; both have the same type
+inline void splice(SEXP out, R_xlen_t start, SEXP part) {
+  const R_xlen_t n = Rf_xlength(part);
+  if (n == 0) {
+    return;
+  }
+  switch (TYPEOF(out)) {
+    case REALSXP:
+      std::memcpy(REAL(out) + start, REAL_RO(part), n * sizeof(double));
+      break;
+    case INTSXP:
+      std::memcpy(INTEGER(out) + start, INTEGER_RO(part), n * sizeof(int));
+      break;
+    case LGLSXP:
+      std::memcpy(LOGICAL(out) + start, LOGICAL_RO(part), n * sizeof(int));
+      break;
+    case CPLXSXP:
+      std::memcpy(COMPLEX(out) + start, COMPLEX_RO(part), n * sizeof(Rcomplex));
+      break;
+    case RAWSXP:
+      std::memcpy(RAW(out) + start, RAW_RO(part), n);
+      break;
+    case STRSXP:
+      for (R_xlen_t i = 0; i < n; ++i) {
+        SET_STRING_ELT(out, start + i, STRING_ELT(part, i));
+      }
+      break;
+    case VECSXP:
+      for (R_xlen_t i = 0; i < n; ++i) {
+        SET_VECTOR_ELT(out, start + i, VECTOR_ELT(part, i));
+      }
+      break;
+    default:
+      stop("Can't combine results of type '%s'", Rf_type2char(TYPEOF(out)));
+  }
+}
+
+}  // namespace detail
+
 class function {
  public:
   // Default constructor: data_ is R_NilValue (via sexp's default constructor).
@@ -75,6 +152,26 @@ class function {
     return try_eval_in(env, std::forward<Args>(args)...);
   }
 
+  // Calls a vectorized function once per `batch_size` elements of `inputs` (an atomic
+  // vector or a list) rather than once per element. Every call must return one value
+  // per element, of the same type each time; the results, and their names if any, are
+  // put back together in the order of `inputs`. Errors say which batch failed.
+  sexp map_batch(SEXP inputs, R_xlen_t batch_size) const {
+    return map_batches(Rf_xlength(inputs), batch_size, [&](R_xlen_t start, R_xlen_t n) {
+      return sexp(detail::slice(inputs, start, n));
+    });
+  }
+
+  // The same for inputs in a `std::vector`, each batch converted with `as_sexp()`
+  template <typename T>
+  sexp map_batch(const std::vector<T>& inputs, R_xlen_t batch_size) const {
+    const R_xlen_t size = static_cast<R_xlen_t>(inputs.size());
+    return map_batches(size, batch_size, [&](R_xlen_t start, R_xlen_t n) {
+      return sexp(as_sexp(std::vector<T>(inputs.begin() + start,
+                                         inputs.begin() + start + n)));
+    });
+  }
+
  private:
   sexp data_;
 
@@ -100,10 +197,65 @@ class function {
     return {sexp(error_flag ? R_NilValue : result), error_flag != 0};
   }
 
+  template <typename F>
+  sexp map_batches(R_xlen_t size, R_xlen_t batch_size, F make_batch) const {
+    if (batch_size <= 0) {
+      stop("`batch_size` must be positive, not %lld", static_cast<long long>(batch_size));
+    }
+    const R_xlen_t nbatches = size == 0 ? 1 : (size + batch_size - 1) / batch_size;
+    sexp out;
+    sexp names;  // allocated once a batch has names; `""` for batches without
+    for (R_xlen_t b = 0; b < nbatches; ++b) {
+      const R_xlen_t start = b * batch_size;
+      const R_xlen_t n = size - start < batch_size ? size - start : batch_size;
+      sexp batch = make_batch(start, n);
+      call_result result = try_eval_in(R_GlobalEnv, batch);
+      if (result.error) {
+        std::string message = result.error_message();
+        while (!message.empty() && message.back() == '\n') message.pop_back();
+        stop("Batch %lld of %lld (inputs %lld to %lld) failed: %s",
+             static_cast<long long>(b + 1), static_cast<long long>(nbatches),
+             static_cast<long long>(start + 1), static_cast<long long>(start + n),
+             message.c_str());
+      }
+      SEXP value = result.value;
+      if (Rf_xlength(value) != n) {
+        stop("Batch %lld (inputs %lld to %lld) returned %lld values, expected %lld",
+             static_cast<long long>(b + 1), static_cast<long long>(start + 1),
+             static_cast<long long>(start + n),
+             static_cast<long long>(Rf_xlength(value)), static_cast<long long>(n));
+      }
+      if (nbatches == 1) {
+        return result.value;
+      }
+      if (b == 0) {
+        out = safe[Rf_allocVector](TYPEOF(value), size);
+        Rf_copyMostAttrib(value, out);
+      } else if (TYPEOF(value) != TYPEOF(out)) {
+        stop("Batch %lld returned a '%s' vector, expected '%s'",
+             static_cast<long long>(b + 1), Rf_type2char(TYPEOF(value)),
+             Rf_type2char(TYPEOF(out)));
+      }
+      detail::splice(out, start, value);
+
+      SEXP value_names = Rf_getAttrib(value, R_NamesSymbol);
+      if (value_names != R_NilValue) {
+        if (names == R_NilValue) {
+          names = safe[Rf_allocVector](STRSXP, size);
+        }
+        detail::splice(names, start, value_names);
+      }
+    }
+    if (names != R_NilValue) {
+      Rf_setAttrib(out, R_NamesSymbol, names);
+    }
+    return out;
+  }
+
   template <typename... Args>
   void construct_call(SEXP val, const named_arg& arg, Args&&... args) const {
     SETCAR(val, arg.value());
-    SET_TAG(val, safe[Rf_install](arg.name()));
+    SET_TAG(val, arg.tag());
     val = CDR(val);
     construct_call(val, std::forward<Args>(args)...);
   }
@@ -120,6 +272,116 @@ class function {
   void construct_call(SEXP /*val*/) const {}
 };
 
+// A call to an R function that is built once and evaluated many times.
+//
+// `function::operator()` allocates a new call and converts every argument each time.
+// `prepared_call` allocates the call once and `set()` replaces one argument in place.
+// Doubles and double vectors are written into the vector the argument already holds
+// when it has the same length, was allocated here and nothing else refers to it, so an
+// optimizer calling an objective function in a loop allocates nothing but the results.
+class prepared_call {
+ public:
+  // A call to `fn` with `nargs` arguments, all `NULL` until they are set
+  prepared_call(const function& fn, int nargs, SEXP env = R_GlobalEnv)
+      : prepared_call(fn, std::vector<const char*>(nargs, ""), env) {}
+
+  // A call to `fn` with one argument per name, `""` for positional arguments
+  prepared_call(const function& fn, std::initializer_list<const char*> names,
+                SEXP env = R_GlobalEnv)
+      : prepared_call(fn, std::vector<const char*>(names), env) {}
+
+  int nargs() const noexcept { return static_cast<int>(cells_.size()); }
+
+  SEXP call() const noexcept { return call_; }
+
+  // Sets argument `i` to `value`, which is used as is (never written to)
+  void set(int i, SEXP value) {
+    SETCAR(cells_[i], value);
+    owned_[i] = false;
+  }
+
+  void set(int i, double value) { set(i, &value, 1); }
+
+  void set(int i, const double* values, R_xlen_t n) {
+    double* p = reusable(i, n);
+    if (p == nullptr) {
+      SEXP buffer = safe[Rf_allocVector](REALSXP, n);
+      SETCAR(cells_[i], buffer);
+      owned_[i] = true;
+      p = REAL(buffer);
+    }
+    if (n > 0) {
+      std::memcpy(p, values, n * sizeof(double));
+    }
+  }
+
+  void set(int i, const std::vector<double>& values) {
+    set(i, values.data(), static_cast<R_xlen_t>(values.size()));
+  }
+
+  // Anything else is converted with `as_sexp()`
+  template <typename T>
+  void set(int i, const T& value) {
+    set(i, static_cast<SEXP>(as_sexp(value)));
+  }
+
+  // Evaluates the call with the arguments as they are, throwing on error
+  sexp operator()() {
+    sexp out = safe[Rf_eval](call_, env_);
+    // A function may return an argument as is; the caller now holds that vector
+    for (std::size_t i = 0; i < cells_.size(); ++i) {
+      if (owned_[i] && CAR(cells_[i]) == out) owned_[i] = false;
+    }
+    return out;
+  }
+
+  // Sets every argument, in order, then evaluates the call
+  template <typename... Args>
+  sexp operator()(Args&&... args) {
+    if (sizeof...(Args) != cells_.size()) {
+      stop("This call takes %d arguments, not %d", nargs(),
+           static_cast<int>(sizeof...(Args)));
+    }
+    int i = 0;
+    const int unused[] = {0, (set(i++, std::forward<Args>(args)), 0)...};
+    (void)unused;
+    return operator()();
+  }
+
+ private:
+  sexp call_;
+  sexp env_;
+  // The cons cells of the arguments, kept alive by `call_`
+  std::vector<SEXP> cells_;
+  // Whether each argument holds a vector allocated by `set()`
+  std::vector<bool> owned_;
+
+  prepared_call(const function& fn, const std::vector<const char*>& names, SEXP env)
+      : env_(env), owned_(names.size(), false) {
+    call_ = safe[Rf_allocVector](LANGSXP, static_cast<R_xlen_t>(names.size()) + 1);
+    SETCAR(call_, fn);
+    SEXP cell = CDR(call_);
+    for (const char* name : names) {
+      if (name != nullptr && name[0] != '\0') {
+        SET_TAG(cell, safe[Rf_install](name));
+      }
+      cells_.push_back(cell);
+      cell = CDR(cell);
+    }
+  }
+
+  double* reusable(int i, R_xlen_t n) const {
+    if (!owned_[i]) {
+      return nullptr;
+    }
+    SEXP current = CAR(cells_[i]);
+    if (Rf_xlength(current) != n || MAYBE_SHARED(current)) {
+      return nullptr;
+    }
+    return REAL(current);
+  }
+};
+
 class package {
  public:
   package(const char* name) : data_(get_namespace(name)) {}
@@ -132,6 +394,7 @@ class package {
     return safe[Rf_findFun](safe[Rf_install](name), data_);
   }
   function operator[](const std::string& name) { return operator[](name.c_str()); }
+  function operator[](const symbol& name) { return safe[Rf_findFun](name, data_); }
 #if CPP4R_HAS_CXX17
   // C++17+: accept string_view directly, avoiding a temporary std::string
   function operator[](std::string_view name) {
@@ -0,0 +1,524 @@
+#pragma once
+
+#include <algorithm>         // for fill
+#include <climits>           // for INT_MAX, INT_MIN
+#include <cstdint>           // for int64_t
+#include <cstring>           // for strcmp, memcpy
+#include <initializer_list>  // for initializer_list
+#include <string>            // for string
+#include <unordered_map>     // for unordered_map
+#include <utility>           // for move
+#include <vector>            // for vector
+
+#include "cpp4r/R.hpp"            // for SEXP, R_xlen_t, NA_INTEGER, NA_REAL, ISNAN
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_NODISCARD
+#include "cpp4r/data_frame.hpp"   // for data_frame, writable::data_frame
+#include "cpp4r/list.hpp"         // for writable::list
+#include "cpp4r/protect.hpp"      // for safe, stop, unwind_protect
+#include "cpp4r/sexp.hpp"         // for sexp
+#include "cpp4r/strings.hpp"      // for writable::strings
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Hash group-by for data frames.
+//
+// `group_by(df, "a", "b")` gives every row a dense group id (0, 1, ...), numbering the
+// groups in order of first appearance, like `dplyr::group_by()` followed by
+// `summarise()`. Each key column is encoded on its own, then the codes are combined
+// column by column:
+//
+//  - integers, factors and logicals index a lookup table when their range is at most a
+//    few times the number of rows, and go through a hash table otherwise;
+//  - strings are hashed by CHARSXP pointer. R keeps one CHARSXP per string and
+//    encoding, so no characters are compared. Strings that are neither ASCII nor
+//    marked as UTF-8 (or as bytes) are translated to UTF-8 first, so the same text in
+//    latin1 and UTF-8 is one group;
+//  - `NA` is a group of its own.
+//
+// `grouping::summarise()` then runs one pass over the rows per aggregation
+// (`agg::count()`, `sum()`, `mean()`, `min()`, `max()`, `first()`, `last()`) and returns
+// a data frame with one row per group: the key columns followed by the aggregations.
+// `NA` propagates, as with the defaults of the R functions. With OpenMP, long inputs are
+// partitioned by group id, each thread updating only its own groups, so the results do
+// not depend on the number of threads.
+
+namespace cpp4r {
+
+namespace agg {
+
+enum class kind { count, sum, mean, min, max, first, last };
+
+struct spec {
+  kind what;
+  std::string column;
+  std::string name;
+};
+
+// Rows per group, as an integer column
+inline spec count(std::string name = "n") { return {kind::count, "", std::move(name)}; }
+
+// The other aggregations are named `<column>_<aggregation>` unless `name` is given
+inline spec make_spec(kind what, std::string column, std::string name,
+                      const char* suffix) {
+  if (name.empty()) name = column + suffix;
+  return {what, std::move(column), std::move(name)};
+}
+
+inline spec sum(std::string column, std::string name = "") {
+  return make_spec(kind::sum, std::move(column), std::move(name), "_sum");
+}
+inline spec mean(std::string column, std::string name = "") {
+  return make_spec(kind::mean, std::move(column), std::move(name), "_mean");
+}
+inline spec min(std::string column, std::string name = "") {
+  return make_spec(kind::min, std::move(column), std::move(name), "_min");
+}
+inline spec max(std::string column, std::string name = "") {
+  return make_spec(kind::max, std::move(column), std::move(name), "_max");
+}
+inline spec first(std::string column, std::string name = "") {
+  return make_spec(kind::first, std::move(column), std::move(name), "_first");
+}
+inline spec last(std::string column, std::string name = "") {
+  return make_spec(kind::last, std::move(column), std::move(name), "_last");
+}
+
+}  // namespace agg
+
+namespace detail {
+namespace group {
+
+// Inputs above this size may be aggregated in parallel
+constexpr R_xlen_t parallel_threshold = R_xlen_t(1) << 16;
+
+// Lookup tables are used up to this many slots per row
+constexpr int64_t table_ratio = 4;
+
+inline int threads_for(R_xlen_t n, int ngroups, bool parallel) {
+#ifdef _OPENMP
+  if (parallel && n >= parallel_threshold && ngroups > 1) {
+    const int nthreads = omp_get_max_threads();
+    return ngroups < nthreads ? ngroups : nthreads;
+  }
+#endif
+  (void)n;
+  (void)ngroups;
+  (void)parallel;
+  return 1;
+}
+
+inline bool use_table(int64_t slots, R_xlen_t n) {
+  return slots <= table_ratio * static_cast<int64_t>(n) + 1024;
+}
+
+// Replaces `key(i)` by dense codes in order of first appearance, returns their number
+template <typename Key, typename F>
+int encode_hashed(R_xlen_t n, int* codes, F key) {
+  std::unordered_map<Key, int> seen;
+  for (R_xlen_t i = 0; i < n; ++i) {
+    auto it = seen.emplace(key(i), static_cast<int>(seen.size())).first;
+    codes[i] = it->second;
+  }
+  return static_cast<int>(seen.size());
+}
+
+template <typename F>
+int encode_table(R_xlen_t n, int64_t slots, int* codes, F slot) {
+  std::vector<int> table(static_cast<std::size_t>(slots), -1);
+  int ncodes = 0;
+  for (R_xlen_t i = 0; i < n; ++i) {
+    int& code = table[static_cast<std::size_t>(slot(i))];
+    if (code < 0) {
+      code = ncodes++;
+    }
+    codes[i] = code;
+  }
+  return ncodes;
+}
+
+inline int encode_ints(const int* x, R_xlen_t n, int* codes) {
+  int lo = INT_MAX, hi = INT_MIN;
+  for (R_xlen_t i = 0; i < n; ++i) {
+    if (x[i] == NA_INTEGER) continue;
+    if (x[i] < lo) lo = x[i];
+    if (x[i] > hi) hi = x[i];
+  }
+  // `NA` takes the slot after `hi`
+  const int64_t range = lo <= hi ? static_cast<int64_t>(hi) - lo + 1 : 0;
+  if (use_table(range + 1, n)) {
+    return encode_table(n, range + 1, codes, [&](R_xlen_t i) {
+      return x[i] == NA_INTEGER ? range : static_cast<int64_t>(x[i]) - lo;
+    });
+  }
+  return encode_hashed<int>(n, codes, [&](R_xlen_t i) { return x[i]; });
+}
+
+// Whether `x` has to be translated to UTF-8 to share its CHARSXP with the same text in
+// other encodings
+inline bool needs_utf8(SEXP x) {
+  if (x == NA_STRING) {
+    return false;
+  }
+  const cetype_t encoding = Rf_getCharCE(x);
+  if (encoding == CE_UTF8 || encoding == CE_BYTES) {
+    return false;
+  }
+  for (const char* p = CHAR(x); *p != '\0'; ++p) {
+    if (static_cast<unsigned char>(*p) > 127) return true;
+  }
+  return false;
+}
+
+// `x`, or a copy of it with the strings that need it translated to UTF-8, so that the
+// same text has the same CHARSXP
+inline SEXP as_utf8(SEXP x) {
+  const R_xlen_t n = Rf_xlength(x);
+  const SEXP* p = STRING_PTR_RO(x);
+  R_xlen_t first = 0;
+  while (first < n && !needs_utf8(p[first])) ++first;
+  if (first == n) {
+    return x;
+  }
+  return unwind_protect([&] {
+    SEXP out = PROTECT(Rf_allocVector(STRSXP, n));
+    for (R_xlen_t i = 0; i < n; ++i) {
+      SEXP value = p[i];
+      if (i >= first && needs_utf8(value)) {
+        value = Rf_mkCharCE(Rf_translateCharUTF8(value), CE_UTF8);
+      }
+      SET_STRING_ELT(out, i, value);
+    }
+    UNPROTECT(1);
+    return out;
+  });
+}
+
+inline int encode_strings(const SEXP* x, R_xlen_t n, int* codes) {
+  return encode_hashed<SEXP>(n, codes, [&](R_xlen_t i) { return x[i]; });
+}
+
+// Combines the group ids so far with the codes of the next key
+inline int combine(int* ids, int ngroups, const int* codes, int ncodes, R_xlen_t n) {
+  const int64_t slots = static_cast<int64_t>(ngroups) * ncodes;
+  auto pair = [&](R_xlen_t i) {
+    return static_cast<int64_t>(ids[i]) * ncodes + codes[i];
+  };
+  if (use_table(slots, n)) {
+    return encode_table(n, slots, ids, pair);
+  }
+  return encode_hashed<int64_t>(n, ids, pair);
+}
+
+// The rows bucketed by `g % nthreads` with a counting sort, keeping their order within
+// a bucket, so that each thread walks only the rows of the groups it owns. Nothing is
+// built for one thread.
+struct partition {
+  int nthreads = 1;
+  std::vector<R_xlen_t> start;  // bucket `b` is `rows[start[b]]` to `rows[start[b + 1]]`
+  std::vector<R_xlen_t> rows;
+
+  partition() = default;
+
+  partition(const int* ids, R_xlen_t n, int threads) : nthreads(threads) {
+    if (nthreads == 1) {
+      return;
+    }
+    start.assign(static_cast<std::size_t>(nthreads) + 1, 0);
+    for (R_xlen_t i = 0; i < n; ++i) {
+      ++start[ids[i] % nthreads + 1];
+    }
+    for (int b = 0; b < nthreads; ++b) {
+      start[b + 1] += start[b];
+    }
+    rows.resize(static_cast<std::size_t>(n));
+    std::vector<R_xlen_t> next(start.begin(), start.end() - 1);
+    for (R_xlen_t i = 0; i < n; ++i) {
+      rows[next[ids[i] % nthreads]++] = i;
+    }
+  }
+};
+
+// Runs `f(i, group)` over the rows, in parallel over the buckets of `part`, so that a
+// group is only ever touched by one thread
+template <typename F>
+void for_rows(const int* ids, R_xlen_t n, const partition& part, F f) {
+  if (part.nthreads == 1) {
+    for (R_xlen_t i = 0; i < n; ++i) {
+      f(i, ids[i]);
+    }
+    return;
+  }
+#ifdef _OPENMP
+#pragma omp parallel num_threads(part.nthreads)
+  {
+    // OpenMP may start fewer threads than asked for
+    const int nt = omp_get_num_threads();
+    for (int b = omp_get_thread_num(); b < part.nthreads; b += nt) {
+      for (R_xlen_t k = part.start[b]; k < part.start[b + 1]; ++k) {
+        const R_xlen_t i = part.rows[k];
+        f(i, ids[i]);
+      }
+    }
+  }
+#endif
+}
+
+inline bool is_na(int x) { return x == NA_INTEGER; }
+inline bool is_na(double x) { return ISNAN(x); }
+
+inline double as_double(int x) { return x == NA_INTEGER ? NA_REAL : x; }
+inline double as_double(double x) { return x; }
+
+template <typename T>
+void sum(const T* x, const int* ids, R_xlen_t n, const partition& part, double* out) {
+  for_rows(ids, n, part, [&](R_xlen_t i, int g) { out[g] += as_double(x[i]); });
+}
+
+// Starts from the first row of each group, which every group has
+template <typename T, bool Max>
+void extreme(const T* x, const int* ids, R_xlen_t n, const partition& part,
+             const std::vector<R_xlen_t>& first, T* out) {
+  for (std::size_t g = 0; g < first.size(); ++g) {
+    out[g] = x[first[g]];
+  }
+  for_rows(ids, n, part, [&](R_xlen_t i, int g) {
+    T& acc = out[g];
+    if (is_na(acc)) return;
+    const T value = x[i];
+    if (is_na(value) || (Max ? value > acc : value < acc)) {
+      acc = value;
+    }
+  });
+}
+
+// `x[rows]`, with `NA` for negative rows, keeping the attributes that describe the
+// values (levels, class, ...)
+inline SEXP gather(SEXP x, const std::vector<R_xlen_t>& rows) {
+  const SEXPTYPE type = TYPEOF(x);
+  const R_xlen_t n = static_cast<R_xlen_t>(rows.size());
+  sexp out = safe[Rf_allocVector](type, n);
+  switch (type) {
+    case REALSXP: {
+      const double* in = REAL_RO(x);
+      double* p = REAL(out);
+      for (R_xlen_t g = 0; g < n; ++g) p[g] = rows[g] < 0 ? NA_REAL : in[rows[g]];
+      break;
+    }
+    case INTSXP:
+    case LGLSXP: {
+      const int* in = type == INTSXP ? INTEGER_RO(x) : LOGICAL_RO(x);
+      int* p = type == INTSXP ? INTEGER(out) : LOGICAL(out);
+      for (R_xlen_t g = 0; g < n; ++g) p[g] = rows[g] < 0 ? NA_INTEGER : in[rows[g]];
+      break;
+    }
+    case CPLXSXP: {
+      const Rcomplex* in = COMPLEX_RO(x);
+      Rcomplex* p = COMPLEX(out);
+      Rcomplex na;
+      na.r = NA_REAL;
+      na.i = NA_REAL;
+      for (R_xlen_t g = 0; g < n; ++g) p[g] = rows[g] < 0 ? na : in[rows[g]];
+      break;
+    }
+    case STRSXP: {
+      for (R_xlen_t g = 0; g < n; ++g) {
+        SET_STRING_ELT(out, g, rows[g] < 0 ? NA_STRING : STRING_ELT(x, rows[g]));
+      }
+      break;
+    }
+    default:
+      for (R_xlen_t g = 0; g < n; ++g) {
+        SET_VECTOR_ELT(out, g, rows[g] < 0 ? R_NilValue : VECTOR_ELT(x, rows[g]));
+      }
+  }
+  Rf_copyMostAttrib(x, out);
+  return out;
+}
+
+// The column of `data` called `name`
+inline SEXP column(SEXP data, const std::string& name) {
+  SEXP names = Rf_getAttrib(data, R_NamesSymbol);
+  const R_xlen_t n = Rf_xlength(data);
+  for (R_xlen_t i = 0; names != R_NilValue && i < n; ++i) {
+    if (std::strcmp(CHAR(STRING_ELT(names, i)), name.c_str()) == 0) {
+      return VECTOR_ELT(data, i);
+    }
+  }
+  stop("Column '%s' is missing", name.c_str());
+}
+
+}  // namespace group
+}  // namespace detail
+
+class grouping {
+  data_frame data_;
+  std::vector<std::string> keys_;
+  R_xlen_t nrow_;
+  int ngroups_ = 0;
+  std::vector<int> ids_;
+  std::vector<R_xlen_t> first_, last_;
+  std::vector<int> sizes_;
+  // Shared by the aggregations of a `summarise()`, built when first run in parallel
+  mutable detail::group::partition partition_;
+
+  const detail::group::partition& partition_for(int nthreads) const {
+    if (partition_.nthreads != nthreads) {
+      partition_ = detail::group::partition(ids_.data(), nrow_, nthreads);
+    }
+    return partition_;
+  }
+
+  SEXP column(const std::string& name) const {
+    return detail::group::column(data_, name);
+  }
+
+  int encode(const std::string& name, int* codes) const {
+    SEXP x = column(name);
+    switch (TYPEOF(x)) {
+      case INTSXP:
+        return detail::group::encode_ints(INTEGER_RO(x), nrow_, codes);
+      case LGLSXP:
+        return detail::group::encode_ints(LOGICAL_RO(x), nrow_, codes);
+      case STRSXP: {
+        sexp utf8 = detail::group::as_utf8(x);
+        return detail::group::encode_strings(STRING_PTR_RO(utf8), nrow_, codes);
+      }
+      default:
+        stop("Can't group by column '%s' of type '%s'", name.c_str(),
+             Rf_type2char(TYPEOF(x)));
+    }
+  }
+
+  SEXP aggregate(const agg::spec& spec, bool parallel) const {
+    if (spec.what == agg::kind::count) {
+      sexp out = safe[Rf_allocVector](INTSXP, ngroups_);
+      if (ngroups_ > 0) {
+        std::memcpy(INTEGER(out), sizes_.data(), ngroups_ * sizeof(int));
+      }
+      return out;
+    }
+
+    SEXP x = column(spec.column);
+    if (spec.what == agg::kind::first) {
+      return detail::group::gather(x, first_);
+    }
+    if (spec.what == agg::kind::last) {
+      return detail::group::gather(x, last_);
+    }
+
+    const SEXPTYPE type = TYPEOF(x);
+    if ((type != REALSXP && type != INTSXP && type != LGLSXP) || Rf_isFactor(x)) {
+      stop("Can't aggregate column '%s' of type '%s'", spec.column.c_str(),
+           Rf_isFactor(x) ? "factor" : Rf_type2char(type));
+    }
+    const detail::group::partition& part =
+        partition_for(detail::group::threads_for(nrow_, ngroups_, parallel));
+    const double* reals = type == REALSXP ? REAL_RO(x) : nullptr;
+    const int* ints = type == INTSXP ? INTEGER_RO(x) : type == LGLSXP ? LOGICAL_RO(x)
+                                                                      : nullptr;
+
+    if (spec.what == agg::kind::sum || spec.what == agg::kind::mean) {
+      sexp out = safe[Rf_allocVector](REALSXP, ngroups_);
+      double* p = REAL(out);
+      std::fill(p, p + ngroups_, 0.);
+      if (reals != nullptr) {
+        detail::group::sum(reals, ids_.data(), nrow_, part, p);
+      } else {
+        detail::group::sum(ints, ids_.data(), nrow_, part, p);
+      }
+      if (spec.what == agg::kind::mean) {
+        for (int g = 0; g < ngroups_; ++g) p[g] /= sizes_[g];
+      }
+      return out;
+    }
+
+    const bool max = spec.what == agg::kind::max;
+    sexp out = safe[Rf_allocVector](type, ngroups_);
+    if (reals != nullptr) {
+      if (max) {
+        detail::group::extreme<double, true>(reals, ids_.data(), nrow_, part, first_,
+                                             REAL(out));
+      } else {
+        detail::group::extreme<double, false>(reals, ids_.data(), nrow_, part, first_,
+                                              REAL(out));
+      }
+    } else {
+      int* p = type == INTSXP ? INTEGER(out) : LOGICAL(out);
+      if (max) {
+        detail::group::extreme<int, true>(ints, ids_.data(), nrow_, part, first_, p);
+      } else {
+        detail::group::extreme<int, false>(ints, ids_.data(), nrow_, part, first_, p);
+      }
+    }
+    Rf_copyMostAttrib(x, out);
+    return out;
+  }
+
+ public:
+  grouping(const data_frame& data, std::vector<std::string> keys)
+      : data_(data), keys_(std::move(keys)), nrow_(data_.nrow()), ids_(nrow_) {
+    if (keys_.empty()) {
+      // One group of all the rows, unless there are none
+      ngroups_ = nrow_ > 0 ? 1 : 0;
+    } else {
+      ngroups_ = encode(keys_[0], ids_.data());
+      std::vector<int> codes(keys_.size() > 1 ? nrow_ : 0);
+      for (std::size_t k = 1; k < keys_.size(); ++k) {
+        const int ncodes = encode(keys_[k], codes.data());
+        ngroups_ = detail::group::combine(ids_.data(), ngroups_, codes.data(), ncodes,
+                                          nrow_);
+      }
+    }
+
+    first_.assign(ngroups_, -1);
+    last_.resize(ngroups_);
+    sizes_.assign(ngroups_, 0);
+    for (R_xlen_t i = 0; i < nrow_; ++i) {
+      const int g = ids_[i];
+      if (first_[g] < 0) first_[g] = i;
+      last_[g] = i;
+      ++sizes_[g];
+    }
+  }
+
+  CPP4R_NODISCARD int ngroups() const noexcept { return ngroups_; }
+  CPP4R_NODISCARD R_xlen_t nrow() const noexcept { return nrow_; }
+
+  // The group of each row, from 0
+  const std::vector<int>& ids() const noexcept { return ids_; }
+  // The number of rows of each group
+  const std::vector<int>& sizes() const noexcept { return sizes_; }
+
+  // The key columns, one row per group
+  writable::data_frame keys() const { return summarise({}); }
+
+  // The key columns followed by one column per aggregation, one row per group
+  writable::data_frame summarise(std::initializer_list<agg::spec> specs,
+                                 bool parallel = true) const {
+    const R_xlen_t ncol = static_cast<R_xlen_t>(keys_.size() + specs.size());
+    writable::list out(ncol);
+    writable::strings names(ncol);
+
+    R_xlen_t j = 0;
+    for (const std::string& key : keys_) {
+      out[j] = detail::group::gather(column(key), first_);
+      names[j++] = key;
+    }
+    for (const agg::spec& spec : specs) {
+      out[j] = aggregate(spec, parallel);
+      names[j++] = spec.name;
+    }
+    out.names() = names;
+    return writable::data_frame(out, false, ngroups_);
+  }
+};
+
+// Groups the rows of `data` by the columns called `keys`
+template <typename... Keys>
+grouping group_by(const data_frame& data, Keys&&... keys) {
+  return grouping(data, std::vector<std::string>{std::string(keys)...});
+}
+
+}  // namespace cpp4r
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cstdint>        // for uint64_t, uintptr_t
+#include <cstring>        // for memcpy, strcmp
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "cpp4r/R.hpp"           // for SEXP, R_xlen_t, NA_INTEGER, NA_REAL, ISNAN
+#include "cpp4r/data_frame.hpp"  // for data_frame, writable::data_frame
+#include "cpp4r/group_by.hpp"    // for detail::group::gather, column, as_utf8
+#include "cpp4r/list.hpp"        // for writable::list
+#include "cpp4r/protect.hpp"     // for stop
+#include "cpp4r/sexp.hpp"        // for sexp
+#include "cpp4r/strings.hpp"     // for writable::strings
+
+// Joins of two data frames on key columns, like `dplyr::inner_join()`, `left_join()`,
+// `semi_join()` and `anti_join()`.
+//
+// `join_rows()` gives the matching rows as 0-based index vectors, in the order of the
+// rows of `x` and, for the rows of `x` with several matches, of `y` (-1 for rows of `x`
+// without a match in a left join). `join()` and the `*_join()` functions gather the
+// columns into a `writable::data_frame` instead.
+//
+// Keys may be integers, logicals, doubles (integers are compared as doubles when the
+// other side is double), strings or factors (compared by level). `NA` matches `NA`.
+// Strings are compared by their text, so a string matches the same text in another
+// encoding: keys that are neither ASCII nor marked as UTF-8 (or as bytes) are translated
+// to UTF-8 first.
+// When there is a single numeric key and both sides are already sorted, the rows are
+// matched with a merge that needs no extra memory. Otherwise a hash table is built on the
+// smaller side, keyed by the hash of the key columns, with the rows of each key chained
+// through one index vector, and the other side is probed against it.
+
+namespace cpp4r {
+
+enum class join_type { inner, left, semi, anti };
+
+struct join_indices {
+  // Rows of `x`
+  std::vector<R_xlen_t> x;
+  // Rows of `y` matched with `x`, -1 when there is none (empty for semi and anti joins)
+  std::vector<R_xlen_t> y;
+};
+
+namespace detail {
+namespace join {
+
+enum class domain { ints, reals, strings };
+
+inline bool is_string_like(SEXP x) { return TYPEOF(x) == STRSXP || Rf_isFactor(x); }
+
+inline domain domain_of(SEXP x, SEXP y, const std::string& name) {
+  const SEXPTYPE tx = TYPEOF(x), ty = TYPEOF(y);
+  if (is_string_like(x) && is_string_like(y)) {
+    return domain::strings;
+  }
+  if (!is_string_like(x) && !is_string_like(y)) {
+    const bool x_int = tx == INTSXP || tx == LGLSXP;
+    const bool y_int = ty == INTSXP || ty == LGLSXP;
+    if (x_int && y_int) {
+      return domain::ints;
+    }
+    if ((x_int || tx == REALSXP) && (y_int || ty == REALSXP)) {
+      return domain::reals;
+    }
+  }
+  stop("Can't join on column '%s' of types '%s' and '%s'", name.c_str(),
+       Rf_isFactor(x) ? "factor" : Rf_type2char(tx),
+       Rf_isFactor(y) ? "factor" : Rf_type2char(ty));
+}
+
+// The values of one key column as 64-bit words that are equal exactly when the values
+// match
+class key_column {
+  domain domain_;
+  const int* ints_ = nullptr;
+  const double* reals_ = nullptr;
+  const SEXP* strings_ = nullptr;
+  const SEXP* levels_ = nullptr;
+  // The strings or levels, translated to UTF-8 where needed
+  sexp utf8_;
+
+ public:
+  key_column(SEXP x, domain d) : domain_(d) {
+    if (Rf_isFactor(x)) {
+      ints_ = INTEGER_RO(x);
+      utf8_ = detail::group::as_utf8(Rf_getAttrib(x, R_LevelsSymbol));
+      levels_ = STRING_PTR_RO(utf8_);
+    } else if (TYPEOF(x) == STRSXP) {
+      utf8_ = detail::group::as_utf8(x);
+      strings_ = STRING_PTR_RO(utf8_);
+    } else if (TYPEOF(x) == REALSXP) {
+      reals_ = REAL_RO(x);
+    } else {
+      ints_ = TYPEOF(x) == INTSXP ? INTEGER_RO(x) : LOGICAL_RO(x);
+    }
+  }
+
+  domain get_domain() const noexcept { return domain_; }
+
+  // The value as a double (numeric keys only)
+  double number(R_xlen_t i) const {
+    if (reals_ != nullptr) {
+      return reals_[i];
+    }
+    return ints_[i] == NA_INTEGER ? NA_REAL : ints_[i];
+  }
+
+  bool is_na(R_xlen_t i) const {
+    return reals_ != nullptr ? ISNAN(reals_[i]) : ints_[i] == NA_INTEGER;
+  }
+
+  uint64_t operator[](R_xlen_t i) const {
+    switch (domain_) {
+      case domain::ints:
+        return static_cast<uint32_t>(ints_[i]);
+      case domain::reals: {
+        double value = number(i);
+        if (value == 0) {
+          value = 0;  // -0 matches 0
+        } else if (R_IsNA(value)) {
+          value = NA_REAL;
+        } else if (ISNAN(value)) {
+          value = R_NaN;
+        }
+        uint64_t out;
+        std::memcpy(&out, &value, sizeof(double));
+        return out;
+      }
+      case domain::strings:
+      default: {
+        SEXP value;
+        if (levels_ != nullptr) {
+          value = ints_[i] == NA_INTEGER ? NA_STRING : levels_[ints_[i] - 1];
+        } else {
+          value = strings_[i];
+        }
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+      }
+    }
+  }
+};
+
+class keys {
+  std::vector<key_column> columns_;
+
+ public:
+  void push_back(key_column column) { columns_.push_back(column); }
+
+  const key_column& operator[](std::size_t k) const { return columns_[k]; }
+  std::size_t size() const noexcept { return columns_.size(); }
+
+  uint64_t hash(R_xlen_t i) const {
+    uint64_t h = 0;
+    for (const key_column& column : columns_) {
+      h ^= column[i] + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+
+  bool same(R_xlen_t i, const keys& other, R_xlen_t j) const {
+    for (std::size_t k = 0; k < columns_.size(); ++k) {
+      if (columns_[k][i] != other.columns_[k][j]) return false;
+    }
+    return true;
+  }
+};
+
+// Rows of the build side, chained by the hash of their keys. Rows come out of a chain
+// in increasing order.
+class hash_table {
+  const keys& keys_;
+  std::unordered_map<uint64_t, R_xlen_t> heads_;
+  std::vector<R_xlen_t> next_;
+
+ public:
+  hash_table(const keys& keys, R_xlen_t n) : keys_(keys), next_(n, -1) {
+    heads_.reserve(static_cast<std::size_t>(n));
+    for (R_xlen_t i = n - 1; i >= 0; --i) {
+      auto it = heads_.emplace(keys_.hash(i), i);
+      if (!it.second) {
+        next_[i] = it.first->second;
+        it.first->second = i;
+      }
+    }
+  }
+
+  // Calls `f(j)` for the rows `j` with the key of row `i` of `probe`, stopping early
+  // when `f` returns false. Returns whether there was any.
+  template <typename F>
+  bool probe(const keys& probe, R_xlen_t i, F f) const {
+    auto it = heads_.find(probe.hash(i));
+    if (it == heads_.end()) {
+      return false;
+    }
+    bool found = false;
+    for (R_xlen_t j = it->second; j >= 0; j = next_[j]) {
+      if (keys_.same(j, probe, i)) {
+        found = true;
+        if (!f(j)) break;
+      }
+    }
+    return found;
+  }
+};
+
+// Whether a numeric key is sorted, without missing values
+inline bool is_sorted(const key_column& key, R_xlen_t n) {
+  for (R_xlen_t i = 0; i < n; ++i) {
+    if (key.is_na(i) || (i > 0 && key.number(i) < key.number(i - 1))) return false;
+  }
+  return true;
+}
+
+// Matches sorted keys; `emit(i, j)` gets -1 for `j` when row `i` of `x` has no match
+template <typename F>
+void merge(const key_column& x, R_xlen_t nx, const key_column& y, R_xlen_t ny,
+           join_type type, F emit) {
+  R_xlen_t start = 0;
+  for (R_xlen_t i = 0; i < nx; ++i) {
+    const double value = x.number(i);
+    while (start < ny && y.number(start) < value) ++start;
+    R_xlen_t end = start;
+    while (end < ny && y.number(end) == value) ++end;
+
+    if (type == join_type::inner || type == join_type::left) {
+      for (R_xlen_t j = start; j < end; ++j) emit(i, j);
+      if (start == end && type == join_type::left) emit(i, -1);
+    } else if ((start < end) == (type == join_type::semi)) {
+      emit(i, -1);
+    }
+  }
+}
+
+}  // namespace join
+}  // namespace detail
+
+// The rows of `x` and `y` that match on the columns called `by`
+inline join_indices join_rows(const data_frame& x, const data_frame& y,
+                              const std::vector<std::string>& by, join_type type) {
+  if (by.empty()) {
+    stop("A join needs at least one key column");
+  }
+  const R_xlen_t nx = x.nrow(), ny = y.nrow();
+  detail::join::keys x_keys, y_keys;
+  for (const std::string& name : by) {
+    SEXP x_col = detail::group::column(x, name);
+    SEXP y_col = detail::group::column(y, name);
+    const detail::join::domain d = detail::join::domain_of(x_col, y_col, name);
+    x_keys.push_back(detail::join::key_column(x_col, d));
+    y_keys.push_back(detail::join::key_column(y_col, d));
+  }
+
+  join_indices out;
+  const bool pairs = type == join_type::inner || type == join_type::left;
+  auto emit = [&](R_xlen_t i, R_xlen_t j) {
+    out.x.push_back(i);
+    if (pairs) out.y.push_back(j);
+  };
+
+  if (by.size() == 1 && x_keys[0].get_domain() != detail::join::domain::strings &&
+      detail::join::is_sorted(x_keys[0], nx) && detail::join::is_sorted(y_keys[0], ny)) {
+    detail::join::merge(x_keys[0], nx, y_keys[0], ny, type, emit);
+    return out;
+  }
+
+  if (ny <= nx) {
+    // Build on `y`, probe with the rows of `x` in order
+    detail::join::hash_table table(y_keys, ny);
+    for (R_xlen_t i = 0; i < nx; ++i) {
+      const bool found = table.probe(x_keys, i, [&](R_xlen_t j) {
+        if (pairs) emit(i, j);
+        return pairs;
+      });
+      if (pairs ? (!found && type == join_type::left)
+                : (found == (type == join_type::semi))) {
+        emit(i, -1);
+      }
+    }
+    return out;
+  }
+
+  // Build on `x`, probe with the rows of `y`, then put the matches back in the order of
+  // `x` with a counting sort (stable, so the rows of `y` stay in order)
+  detail::join::hash_table table(x_keys, nx);
+  std::vector<R_xlen_t> counts(nx + 1, 0);
+  std::vector<R_xlen_t> match_x, match_y;
+  for (R_xlen_t j = 0; j < ny; ++j) {
+    table.probe(y_keys, j, [&](R_xlen_t i) {
+      ++counts[i + 1];
+      if (pairs) {
+        match_x.push_back(i);
+        match_y.push_back(j);
+      }
+      return true;
+    });
+  }
+
+  if (!pairs) {
+    for (R_xlen_t i = 0; i < nx; ++i) {
+      if ((counts[i + 1] > 0) == (type == join_type::semi)) emit(i, -1);
+    }
+    return out;
+  }
+
+  if (type == join_type::left) {
+    for (R_xlen_t i = 0; i < nx; ++i) {
+      if (counts[i + 1] == 0) counts[i + 1] = 1;
+    }
+  }
+  for (R_xlen_t i = 0; i < nx; ++i) {
+    counts[i + 1] += counts[i];
+  }
+  out.x.assign(counts[nx], 0);
+  out.y.assign(counts[nx], -1);
+  std::vector<R_xlen_t> next(counts.begin(), counts.end() - 1);
+  for (std::size_t k = 0; k < match_x.size(); ++k) {
+    const R_xlen_t to = next[match_x[k]]++;
+    out.x[to] = match_x[k];
+    out.y[to] = match_y[k];
+  }
+  if (type == join_type::left) {
+    for (R_xlen_t i = 0; i < nx; ++i) {
+      if (next[i] < counts[i + 1]) out.x[next[i]] = i;
+    }
+  }
+  return out;
+}
+
+// `x` joined with `y` on the columns called `by`. Inner and left joins add the other
+// columns of `y`; names found on both sides get the suffixes `.x` and `.y`.
+inline writable::data_frame join(const data_frame& x, const data_frame& y,
+                                 const std::vector<std::string>& by, join_type type) {
+  const join_indices rows = join_rows(x, y, by, type);
+  const bool pairs = type == join_type::inner || type == join_type::left;
+
+  auto is_key = [&](const char* name) {
+    for (const std::string& key : by) {
+      if (key == name) return true;
+    }
+    return false;
+  };
+
+  SEXP x_names = Rf_getAttrib(x, R_NamesSymbol);
+  SEXP y_names = Rf_getAttrib(y, R_NamesSymbol);
+  const R_xlen_t nx = Rf_xlength(x), ny = pairs ? Rf_xlength(y) : 0;
+
+  auto in_names = [&](SEXP names, R_xlen_t n, const char* name) {
+    for (R_xlen_t j = 0; j < n; ++j) {
+      if (std::strcmp(CHAR(STRING_ELT(names, j)), name) == 0) return true;
+    }
+    return false;
+  };
+
+  R_xlen_t ncol = nx;
+  for (R_xlen_t j = 0; j < ny; ++j) {
+    if (!is_key(CHAR(STRING_ELT(y_names, j)))) ++ncol;
+  }
+  writable::list out(ncol);
+  writable::strings names(ncol);
+
+  R_xlen_t k = 0;
+  for (R_xlen_t j = 0; j < nx; ++j) {
+    const char* name = CHAR(STRING_ELT(x_names, j));
+    out[k] = detail::group::gather(VECTOR_ELT(x, j), rows.x);
+    const bool clash = !is_key(name) && in_names(y_names, ny, name);
+    names[k++] = clash ? std::string(name) + ".x" : std::string(name);
+  }
+  for (R_xlen_t j = 0; j < ny; ++j) {
+    const char* name = CHAR(STRING_ELT(y_names, j));
+    if (is_key(name)) continue;
+    out[k] = detail::group::gather(VECTOR_ELT(y, j), rows.y);
+    const bool clash = in_names(x_names, nx, name);
+    names[k++] = clash ? std::string(name) + ".y" : std::string(name);
+  }
+  out.names() = names;
+  return writable::data_frame(out, false, static_cast<R_xlen_t>(rows.x.size()));
+}
+
+inline writable::data_frame inner_join(const data_frame& x, const data_frame& y,
+                                       const std::vector<std::string>& by) {
+  return join(x, y, by, join_type::inner);
+}
+
+inline writable::data_frame left_join(const data_frame& x, const data_frame& y,
+                                      const std::vector<std::string>& by) {
+  return join(x, y, by, join_type::left);
+}
+
+inline writable::data_frame semi_join(const data_frame& x, const data_frame& y,
+                                      const std::vector<std::string>& by) {
+  return join(x, y, by, join_type::semi);
+}
+
+inline writable::data_frame anti_join(const data_frame& x, const data_frame& y,
+                                      const std::vector<std::string>& by) {
+  return join(x, y, by, join_type::anti);
+}
+
+}  // namespace cpp4r
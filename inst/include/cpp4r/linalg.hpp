@@ -0,0 +1,335 @@
+#pragma once
+
+// R's BLAS and LAPACK headers take the lengths of character arguments when this is
+// defined, which is what the Fortran routines expect
+#ifndef USE_FC_LEN_T
+#define USE_FC_LEN_T
+#endif
+#include <Rconfig.h>
+#include <R_ext/BLAS.h>
+#include <R_ext/Lapack.h>
+#ifndef FCONE
+#define FCONE
+#endif
+
+#include <algorithm>    // for copy, fill, max
+#include <type_traits>  // for decay, enable_if, is_same
+#include <vector>       // for vector
+
+#include "cpp4r/R.hpp"         // for SEXP, REAL, REAL_RO
+#include "cpp4r/doubles.hpp"   // for doubles
+#include "cpp4r/integers.hpp"  // for integers
+#include "cpp4r/matrix.hpp"    // for doubles_matrix, by_column
+#include "cpp4r/protect.hpp"   // for stop
+
+// Dense linear algebra on column-major double matrices through the BLAS and LAPACK that
+// R was built with. Inputs (whole matrices or `block()` views of them) are passed to the
+// Fortran routines by pointer and leading dimension, without copies; routines that work
+// in place (the factorizations and solves) write into a fresh matrix that is returned.
+//
+// This header isn't part of `cpp4r.hpp`: include `cpp4r/linalg.hpp` directly and link
+// against R's libraries in `src/Makevars`:
+//
+//   PKG_LIBS = $(LAPACK_LIBS) $(BLAS_LIBS) $(FLIBS)
+
+namespace cpp4r {
+namespace linalg {
+
+// LU factorization with partial pivoting, as returned by `getrf()`: `L` (unit diagonal,
+// below the diagonal) and `U` (on and above it) packed together, and the 1-based pivots
+struct lu {
+  writable::doubles_matrix<by_column> factors;
+  writable::integers pivots;
+};
+
+// QR factorization, as returned by `geqrf()`: `R` on and above the diagonal and the
+// Householder vectors below it, plus their scaling factors
+struct qr {
+  writable::doubles_matrix<by_column> factors;
+  writable::doubles tau;
+};
+
+// A read-only column-major input: the address of its first element, its dimensions and
+// the distance between its columns. Built implicitly from double matrices and from
+// blocks of them, which must outlive it.
+class operand {
+  const double* data_;
+  int nrow_, ncol_, ld_;
+
+  // Elements of writable matrices are `double&`
+  template <typename T>
+  using if_double = typename std::enable_if<
+      std::is_same<typename std::decay<T>::type, double>::value>::type;
+
+ public:
+  template <typename V, typename T, typename S, typename = if_double<T>>
+  operand(const matrix<V, T, S>& x)
+      : data_(REAL_RO(x.data())), nrow_(x.nrow()), ncol_(x.ncol()), ld_(x.nrow()) {}
+
+  template <typename V, typename T, typename S, typename = if_double<T>>
+  operand(const matrix_block<matrix<V, T, S>>& x)
+      : data_(REAL_RO(x.parent().data()) + x.row_offset() +
+              static_cast<R_xlen_t>(x.col_offset()) * x.ld()),
+        nrow_(x.nrow()),
+        ncol_(x.ncol()),
+        ld_(x.ld()) {}
+
+  const double* data() const noexcept { return data_; }
+  int nrow() const noexcept { return nrow_; }
+  int ncol() const noexcept { return ncol_; }
+  // BLAS wants at least 1, even for matrices without rows
+  int ld() const noexcept { return std::max(1, ld_); }
+};
+
+namespace detail {
+
+// Leading dimension of a column-major matrix with `nrow` rows
+inline int ld(int nrow) { return std::max(1, nrow); }
+
+inline writable::doubles_matrix<by_column> copy(const operand& x) {
+  writable::doubles_matrix<by_column> out(x.nrow(), x.ncol());
+  double* dst = REAL(out.data());
+  for (int j = 0; j < x.ncol(); ++j) {
+    const double* col = x.data() + static_cast<R_xlen_t>(j) * x.ld();
+    std::copy(col, col + x.nrow(), dst + static_cast<R_xlen_t>(j) * x.nrow());
+  }
+  return out;
+}
+
+inline void check_square(const operand& x) {
+  if (x.nrow() != x.ncol()) {
+    stop("'a' (%d x %d) must be square", x.nrow(), x.ncol());
+  }
+}
+
+}  // namespace detail
+
+// `c <- alpha * op(a) %*% op(b) + beta * c`, where `op()` optionally transposes
+inline void gemm(const operand& a, const operand& b,
+                 writable::doubles_matrix<by_column>& c, double alpha = 1.0,
+                 double beta = 0.0, bool trans_a = false, bool trans_b = false) {
+  const int m = trans_a ? a.ncol() : a.nrow();
+  const int k = trans_a ? a.nrow() : a.ncol();
+  const int kb = trans_b ? b.ncol() : b.nrow();
+  const int n = trans_b ? b.nrow() : b.ncol();
+  if (k != kb || c.nrow() != m || c.ncol() != n) {
+    stop("non-conformable arguments");
+  }
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0) {
+    double* pc = REAL(c.data());
+    for (R_xlen_t i = 0; i < c.size(); ++i) {
+      pc[i] *= beta;
+    }
+    return;
+  }
+
+  const char ta = trans_a ? 'T' : 'N';
+  const char tb = trans_b ? 'T' : 'N';
+  const int lda = a.ld();
+  const int ldb = b.ld();
+  const int ldc = detail::ld(m);
+  F77_CALL(dgemm)(&ta, &tb, &m, &n, &k, &alpha, a.data(), &lda, b.data(), &ldb, &beta,
+                  REAL(c.data()), &ldc FCONE FCONE);
+}
+
+// `alpha * op(a) %*% op(b)`
+inline writable::doubles_matrix<by_column> gemm(const operand& a, const operand& b,
+                                                bool trans_a = false,
+                                                bool trans_b = false,
+                                                double alpha = 1.0) {
+  writable::doubles_matrix<by_column> c(trans_a ? a.ncol() : a.nrow(),
+                                        trans_b ? b.nrow() : b.ncol());
+  // `k == 0` reads `c`, which has to start from zero then
+  std::fill(REAL(c.data()), REAL(c.data()) + c.size(), 0.0);
+  gemm(a, b, c, alpha, 0.0, trans_a, trans_b);
+  return c;
+}
+
+// `alpha * crossprod(a)` (`t(a) %*% a`), or `alpha * tcrossprod(a)` (`a %*% t(a)`) when
+// `trans = false`. BLAS fills one triangle; the other is mirrored.
+inline writable::doubles_matrix<by_column> syrk(const operand& a, bool trans = true,
+                                                double alpha = 1.0) {
+  const int n = trans ? a.ncol() : a.nrow();
+  const int k = trans ? a.nrow() : a.ncol();
+  writable::doubles_matrix<by_column> c(n, n);
+  double* pc = REAL(c.data());
+  std::fill(pc, pc + c.size(), 0.0);
+  if (n == 0 || k == 0) {
+    return c;
+  }
+
+  const char uplo = 'U';
+  const char t = trans ? 'T' : 'N';
+  const int lda = a.ld();
+  const double beta = 0.0;
+  F77_CALL(dsyrk)(&uplo, &t, &n, &k, &alpha, a.data(), &lda, &beta, pc, &n FCONE FCONE);
+
+  for (int j = 0; j < n; ++j) {
+    for (int i = j + 1; i < n; ++i) {
+      pc[i + static_cast<R_xlen_t>(j) * n] = pc[j + static_cast<R_xlen_t>(i) * n];
+    }
+  }
+  return c;
+}
+
+// `alpha * op(a) %*% x`
+inline writable::doubles gemv(const operand& a, const doubles& x,
+                              bool trans = false, double alpha = 1.0) {
+  const int m = a.nrow();
+  const int n = a.ncol();
+  if (x.size() != (trans ? m : n)) {
+    stop("non-conformable arguments");
+  }
+  writable::doubles y(trans ? n : m);
+  double* py = REAL(y.data());
+  std::fill(py, py + y.size(), 0.0);
+  if (m == 0 || n == 0) {
+    return y;
+  }
+
+  const char t = trans ? 'T' : 'N';
+  const int lda = a.ld();
+  const int inc = 1;
+  const double beta = 0.0;
+  F77_CALL(dgemv)(&t, &m, &n, &alpha, a.data(), &lda, REAL(x.data()), &inc, &beta,
+                  py, &inc FCONE);
+  return y;
+}
+
+// Cholesky factor `R` of a symmetric positive definite `a`, with `t(R) %*% R == a`
+// (like `chol()`). Only the upper triangle of `a` is read.
+inline writable::doubles_matrix<by_column> potrf(const operand& a) {
+  detail::check_square(a);
+  writable::doubles_matrix<by_column> r = detail::copy(a);
+  const int n = a.nrow();
+  double* pr = REAL(r.data());
+
+  const char uplo = 'U';
+  const int lda = detail::ld(n);
+  int info = 0;
+  F77_CALL(dpotrf)(&uplo, &n, pr, &lda, &info FCONE);
+  if (info > 0) {
+    stop("the leading minor of order %d is not positive", info);
+  }
+  if (info < 0) {
+    stop("argument %d of Lapack routine %s had invalid value", -info, "dpotrf");
+  }
+
+  for (int j = 0; j < n; ++j) {
+    for (int i = j + 1; i < n; ++i) {
+      pr[i + static_cast<R_xlen_t>(j) * n] = 0.0;
+    }
+  }
+  return r;
+}
+
+// Solves `a %*% x = b` given the Cholesky factor `r` of `a` from `potrf()`
+inline writable::doubles_matrix<by_column> potrs(const operand& r, const operand& b) {
+  detail::check_square(r);
+  if (b.nrow() != r.nrow()) {
+    stop("non-conformable arguments");
+  }
+  writable::doubles_matrix<by_column> x = detail::copy(b);
+  const int n = r.nrow();
+  const int nrhs = b.ncol();
+  if (n == 0 || nrhs == 0) {
+    return x;
+  }
+
+  const char uplo = 'U';
+  const int lda = r.ld();
+  const int ldb = detail::ld(n);
+  int info = 0;
+  F77_CALL(dpotrs)(&uplo, &n, &nrhs, r.data(), &lda, REAL(x.data()), &ldb, &info FCONE);
+  if (info < 0) {
+    stop("argument %d of Lapack routine %s had invalid value", -info, "dpotrs");
+  }
+  return x;
+}
+
+// LU factorization of a general `m x n` matrix. A singular `a` is factorized all the
+// same (`U` then has a zero on its diagonal); `getrs()` refuses to solve with it.
+inline lu getrf(const operand& a) {
+  const int m = a.nrow();
+  const int n = a.ncol();
+  lu out{detail::copy(a), writable::integers(std::min(m, n))};
+  if (m == 0 || n == 0) {
+    return out;
+  }
+
+  const int lda = detail::ld(m);
+  int info = 0;
+  F77_CALL(dgetrf)(&m, &n, REAL(out.factors.data()), &lda, INTEGER(out.pivots.data()),
+                   &info);
+  if (info < 0) {
+    stop("argument %d of Lapack routine %s had invalid value", -info, "dgetrf");
+  }
+  return out;
+}
+
+// Solves `op(a) %*% x = b` given the LU factorization of a square `a` from `getrf()`
+inline writable::doubles_matrix<by_column> getrs(const lu& f, const operand& b,
+                                                 bool trans = false) {
+  const operand factors(f.factors);
+  detail::check_square(factors);
+  const int n = factors.nrow();
+  if (b.nrow() != n) {
+    stop("non-conformable arguments");
+  }
+  const double* pf = factors.data();
+  for (int i = 0; i < n; ++i) {
+    if (pf[i + static_cast<R_xlen_t>(i) * n] == 0.0) {
+      stop("Lapack routine %s: system is exactly singular: U[%d,%d] = 0", "dgetrs", i + 1,
+           i + 1);
+    }
+  }
+
+  writable::doubles_matrix<by_column> x = detail::copy(b);
+  const int nrhs = b.ncol();
+  if (n == 0 || nrhs == 0) {
+    return x;
+  }
+
+  const char t = trans ? 'T' : 'N';
+  const int lda = detail::ld(n);
+  int info = 0;
+  F77_CALL(dgetrs)(&t, &n, &nrhs, pf, &lda, INTEGER(integers(f.pivots).data()),
+                   REAL(x.data()), &lda, &info FCONE);
+  if (info < 0) {
+    stop("argument %d of Lapack routine %s had invalid value", -info, "dgetrs");
+  }
+  return x;
+}
+
+// Householder QR factorization of a general `m x n` matrix
+inline qr geqrf(const operand& a) {
+  const int m = a.nrow();
+  const int n = a.ncol();
+  qr out{detail::copy(a), writable::doubles(std::min(m, n))};
+  if (m == 0 || n == 0) {
+    return out;
+  }
+
+  const int lda = detail::ld(m);
+  double* pa = REAL(out.factors.data());
+  double* tau = REAL(out.tau.data());
+  int info = 0;
+
+  // Workspace query first, then the factorization with the optimal block size
+  int lwork = -1;
+  double size = 0;
+  F77_CALL(dgeqrf)(&m, &n, pa, &lda, tau, &size, &lwork, &info);
+  lwork = std::max(1, static_cast<int>(size));
+  std::vector<double> work(lwork);
+  F77_CALL(dgeqrf)(&m, &n, pa, &lda, tau, work.data(), &lwork, &info);
+  if (info < 0) {
+    stop("argument %d of Lapack routine %s had invalid value", -info, "dgeqrf");
+  }
+  return out;
+}
+
+}  // namespace linalg
+}  // namespace cpp4r
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "cpp4r/R.hpp"
 #include "cpp4r/attribute_proxy.hpp"
@@ -79,18 +82,31 @@ inline SEXP coerce_matrix_sexp(SEXP x) {
   return result;
 }
 
+// Budget for the scratch buffer of a tile of rows: about the size of an L2 cache
+constexpr std::size_t row_tile_bytes = 256 * 1024;
+
+// Edge of the square tiles that `transpose()` moves at a time
+constexpr int transpose_tile = 32;
+
 }  // namespace detail
 
+// R keeps each dimension in an `int`, but a matrix can have more than `INT_MAX`
+// elements (a long vector), so the dimensions are held as `R_xlen_t` and every offset
+// into the data is computed in 64 bits.
 struct matrix_dims {
  protected:
-  const int nrow_;
-  const int ncol_;
+  const R_xlen_t nrow_;
+  const R_xlen_t ncol_;
 
  public:
   matrix_dims(SEXP data) : nrow_(Rf_nrows(data)), ncol_(Rf_ncols(data)) {}
-  matrix_dims(int nrow, int ncol) : nrow_(nrow), ncol_(ncol) {}
-  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int nrow() const noexcept { return nrow_; }
-  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int ncol() const noexcept { return ncol_; }
+  matrix_dims(R_xlen_t nrow, R_xlen_t ncol) : nrow_(nrow), ncol_(ncol) {}
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int nrow() const noexcept {
+    return static_cast<int>(nrow_);
+  }
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int ncol() const noexcept {
+    return static_cast<int>(ncol_);
+  }
 };
 
 struct matrix_slice {};
@@ -107,8 +123,8 @@ struct matrix_slices<by_row> : public matrix_dims {
   using matrix_dims::matrix_dims;
   CPP4R_ALWAYS_INLINE int nslices() const noexcept { return nrow(); }
   CPP4R_ALWAYS_INLINE int slice_size() const noexcept { return ncol(); }
-  CPP4R_ALWAYS_INLINE int slice_stride() const noexcept { return nrow(); }
-  CPP4R_ALWAYS_INLINE int slice_offset(int pos) const noexcept { return pos; }
+  CPP4R_ALWAYS_INLINE R_xlen_t slice_stride() const noexcept { return nrow_; }
+  CPP4R_ALWAYS_INLINE R_xlen_t slice_offset(R_xlen_t pos) const noexcept { return pos; }
 };
 
 template <>
@@ -116,10 +132,15 @@ struct matrix_slices<by_column> : public matrix_dims {
   using matrix_dims::matrix_dims;
   CPP4R_ALWAYS_INLINE int nslices() const noexcept { return ncol(); }
   CPP4R_ALWAYS_INLINE int slice_size() const noexcept { return nrow(); }
-  CPP4R_ALWAYS_INLINE int slice_stride() const noexcept { return 1; }
-  CPP4R_ALWAYS_INLINE int slice_offset(int pos) const noexcept { return pos * nrow(); }
+  CPP4R_ALWAYS_INLINE R_xlen_t slice_stride() const noexcept { return 1; }
+  CPP4R_ALWAYS_INLINE R_xlen_t slice_offset(R_xlen_t pos) const noexcept {
+    return pos * nrow_;
+  }
 };
 
+template <typename M>
+class matrix_block;
+
 template <typename V, typename T, typename S = by_column>
 class matrix : public matrix_slices<S> {
   V vector_;
@@ -133,10 +154,10 @@ class matrix : public matrix_slices<S> {
 
   class slice {
     const matrix& parent_;
-    int index_, offset_;
+    R_xlen_t index_, offset_;
 
    public:
-    slice(const matrix& parent, int index)
+    slice(const matrix& parent, R_xlen_t index)
         : parent_(parent), index_(index), offset_(parent.slice_offset(index)) {}
 
     R_xlen_t stride() const noexcept { return parent_.slice_stride(); }
@@ -145,13 +166,13 @@ class matrix : public matrix_slices<S> {
       return index_ == rhs.index_ && parent_.data() == rhs.parent_.data();
     }
     bool operator!=(const slice& rhs) const noexcept { return !(*this == rhs); }
-    CPP4R_ALWAYS_INLINE T operator[](int pos) const {
+    CPP4R_ALWAYS_INLINE T operator[](R_xlen_t pos) const {
       return parent_.vector_[offset_ + stride() * pos];
     }
 
     class iterator {
       const slice& slice_;
-      int pos_;
+      R_xlen_t pos_;
 
      public:
       using difference_type = std::ptrdiff_t;
@@ -178,7 +199,7 @@ class matrix : public matrix_slices<S> {
 
   class slice_iterator {
     const matrix& parent_;
-    int pos_;
+    R_xlen_t pos_;
 
    public:
     using difference_type = std::ptrdiff_t;
@@ -199,6 +220,111 @@ class matrix : public matrix_slices<S> {
     slice operator*() { return parent_[pos_]; }
   };
 
+  // A block of consecutive rows copied into a contiguous row-major buffer, so that a
+  // row can be read as `ncol()` adjacent elements instead of with stride `nrow()`
+  class row_tile {
+    const scalar_type* data_;
+    int first_row_, nrow_, ncol_;
+
+   public:
+    row_tile(const scalar_type* data, int first_row, int nrow, int ncol)
+        : data_(data), first_row_(first_row), nrow_(nrow), ncol_(ncol) {}
+
+    // Row of the matrix that the first row of the tile comes from
+    int first_row() const noexcept { return first_row_; }
+    int nrow() const noexcept { return nrow_; }
+    int ncol() const noexcept { return ncol_; }
+
+    CPP4R_ALWAYS_INLINE const scalar_type* row(int i) const noexcept {
+      return data_ + static_cast<R_xlen_t>(i) * ncol_;
+    }
+    CPP4R_ALWAYS_INLINE scalar_type operator()(int i, int j) const noexcept {
+      return row(i)[j];
+    }
+  };
+
+  // Single-pass range over the row tiles of a matrix. The scratch buffer is shared by
+  // all tiles, so a tile is only valid until the iterator moves on.
+  class row_tiles_range {
+    const matrix& parent_;
+    int tile_rows_;
+    std::vector<scalar_type> scratch_;
+
+    // Reads the tile column by column, so that the matrix is read contiguously and only
+    // the (cache-resident) scratch buffer is written with a stride
+    void fill(int first_row, int nrow, std::true_type /* raw pointer */) {
+      const int ncol = parent_.ncol();
+      const underlying_type* p = parent_.data_ptr();
+      if (p == nullptr) {
+        fill(first_row, nrow, std::false_type{});
+        return;
+      }
+      scalar_type* out = scratch_.data();
+      for (int j = 0; j < ncol; ++j) {
+        const underlying_type* col =
+            p + first_row + static_cast<R_xlen_t>(j) * parent_.nrow();
+        for (int i = 0; i < nrow; ++i) {
+          out[static_cast<R_xlen_t>(i) * ncol + j] = col[i];
+        }
+      }
+    }
+
+    void fill(int first_row, int nrow, std::false_type) {
+      const int ncol = parent_.ncol();
+      for (int j = 0; j < ncol; ++j) {
+        for (int i = 0; i < nrow; ++i) {
+          scratch_[static_cast<R_xlen_t>(i) * ncol + j] = parent_(first_row + i, j);
+        }
+      }
+    }
+
+   public:
+    row_tiles_range(const matrix& parent, int tile_rows) : parent_(parent) {
+      if (tile_rows <= 0) {
+        const int ncol = parent.ncol() > 0 ? parent.ncol() : 1;
+        const std::size_t row_bytes = sizeof(scalar_type) * static_cast<size_t>(ncol);
+        const std::size_t fit = detail::row_tile_bytes / row_bytes;
+        // At least one cache line of every column per tile
+        tile_rows = fit < 8 ? 8 : static_cast<int>(fit);
+      }
+      tile_rows_ = tile_rows < parent.nrow() ? tile_rows : parent.nrow();
+      scratch_.resize(static_cast<std::size_t>(tile_rows_) * parent.ncol());
+    }
+
+    class iterator {
+      row_tiles_range* range_;
+      int first_row_;
+
+     public:
+      using difference_type = std::ptrdiff_t;
+      using value_type = row_tile;
+      using pointer = row_tile*;
+      using reference = row_tile;
+      using iterator_category = std::input_iterator_tag;
+
+      iterator(row_tiles_range* range, int first_row)
+          : range_(range), first_row_(first_row) {}
+      iterator& operator++() {
+        first_row_ += range_->tile_rows_;
+        if (first_row_ > range_->parent_.nrow()) first_row_ = range_->parent_.nrow();
+        return *this;
+      }
+      bool operator==(const iterator& rhs) const { return first_row_ == rhs.first_row_; }
+      bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+      row_tile operator*() const {
+        const int remaining = range_->parent_.nrow() - first_row_;
+        const int nrow = remaining < range_->tile_rows_ ? remaining : range_->tile_rows_;
+        range_->fill(first_row_, nrow,
+                     std::integral_constant<
+                         bool, std::is_same<underlying_type, scalar_type>::value>{});
+        return {range_->scratch_.data(), first_row_, nrow, range_->parent_.ncol()};
+      }
+    };
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, parent_.nrow()}; }
+  };
+
   matrix(SEXP data)
       : matrix_slices<S>(data), vector_(detail::coerce_matrix_sexp<scalar_type>(data)) {}
 
@@ -262,20 +388,86 @@ class matrix : public matrix_slices<S> {
     return vector_.data_ptr_writable();
   }
 
-  CPP4R_ALWAYS_INLINE T operator()(int row, int col) const {
-    return vector_[row + col * nrow()];
+  CPP4R_ALWAYS_INLINE T operator()(R_xlen_t row, R_xlen_t col) const {
+    return vector_[row + col * this->nrow_];
   }
 
   template <typename V2 = V, typename = decltype(std::declval<V2>().data_ptr_writable())>
-  CPP4R_ALWAYS_INLINE typename V2::reference operator()(int row, int col) {
-    return vector_[row + col * nrow()];
+  CPP4R_ALWAYS_INLINE typename V2::reference operator()(R_xlen_t row, R_xlen_t col) {
+    return vector_[row + col * this->nrow_];
   }
 
-  slice operator[](int index) const { return {*this, index}; }
+  // Iterates over blocks of `tile_rows` rows (by default as many as fit in about 256KB)
+  // as contiguous row-major tiles, a cache-friendly alternative to `by_row` slices for
+  // row-wise algorithms on column-major matrices
+  row_tiles_range row_tiles(int tile_rows = 0) const { return {*this, tile_rows}; }
+
+  // Zero-copy view of the `nrow x ncol` block whose top-left element is
+  // `(row, col)`. The view refers to this matrix, which has to outlive it.
+  matrix_block<matrix> block(int row, int col, int nrow, int ncol) const {
+    return {*this, row, col, nrow, ncol};
+  }
+
+  slice operator[](R_xlen_t index) const { return {*this, index}; }
   slice_iterator begin() const { return {*this, 0}; }
   slice_iterator end() const { return {*this, nslices()}; }
 };
 
+// A rectangular block of a matrix, viewed in place: element `(i, j)` of the block is
+// element `(row_offset() + i, col_offset() + j)` of the parent. Like a sub-matrix in
+// BLAS, the block is `data_ptr()` with leading dimension `ld()` (the number of rows of
+// the parent), so it can be handed to routines that take an `lda`.
+template <typename M>
+class matrix_block {
+  const M& parent_;
+  int row_, col_, nrow_, ncol_;
+
+ public:
+  using underlying_type = typename M::underlying_type;
+  using scalar_type = typename M::scalar_type;
+
+  matrix_block(const M& parent, int row, int col, int nrow, int ncol)
+      : parent_(parent), row_(row), col_(col), nrow_(nrow), ncol_(ncol) {
+    if (row < 0 || col < 0 || nrow < 0 || ncol < 0 || row > parent.nrow() - nrow ||
+        col > parent.ncol() - ncol) {
+      stop("Block of %d x %d at [%d, %d] is out of bounds for a %d x %d matrix", nrow,
+           ncol, row, col, parent.nrow(), parent.ncol());
+    }
+  }
+
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int nrow() const noexcept { return nrow_; }
+  CPP4R_NODISCARD CPP4R_ALWAYS_INLINE int ncol() const noexcept { return ncol_; }
+  CPP4R_NODISCARD R_xlen_t size() const noexcept {
+    return static_cast<R_xlen_t>(nrow_) * ncol_;
+  }
+
+  int row_offset() const noexcept { return row_; }
+  int col_offset() const noexcept { return col_; }
+  int ld() const noexcept { return parent_.nrow(); }
+  const M& parent() const noexcept { return parent_; }
+
+  // First element of the block, or `nullptr` when the parent has no raw data pointer
+  // (ALTREP and string matrices)
+  CPP4R_NODISCARD const underlying_type* data_ptr() const noexcept {
+    const underlying_type* p = parent_.data_ptr();
+    return p == nullptr ? nullptr : p + row_ + static_cast<R_xlen_t>(col_) * ld();
+  }
+
+  CPP4R_ALWAYS_INLINE auto operator()(int i, int j) const -> decltype(parent_(i, j)) {
+    return parent_(row_ + i, col_ + j);
+  }
+
+  // A block of this block, still viewing the same parent
+  matrix_block block(int row, int col, int nrow, int ncol) const {
+    if (row < 0 || col < 0 || nrow < 0 || ncol < 0 || row > nrow_ - nrow ||
+        col > ncol_ - ncol) {
+      stop("Block of %d x %d at [%d, %d] is out of bounds for a %d x %d block", nrow,
+           ncol, row, col, nrow_, ncol_);
+    }
+    return {parent_, row_ + row, col_ + col, nrow, ncol};
+  }
+};
+
 // Read-only matrix aliases
 template <typename S = by_column>
 using doubles_matrix = matrix<r_vector<double>, double, S>;
@@ -304,4 +496,114 @@ using complexes_matrix =
     matrix<r_vector<r_complex>, typename r_vector<r_complex>::reference, S>;
 }  // namespace writable
 
+namespace detail {
+
+template <typename V, typename T, typename S>
+int leading_dim(const matrix<V, T, S>& x) {
+  return x.nrow();
+}
+
+template <typename M>
+int leading_dim(const matrix_block<M>& x) {
+  return x.ld();
+}
+
+template <typename M, typename Out>
+void transpose_into(const M& x, Out& out, std::false_type) {
+  const int nrow = x.nrow();
+  const int ncol = x.ncol();
+  for (int j0 = 0; j0 < ncol; j0 += transpose_tile) {
+    const int j1 = j0 + transpose_tile < ncol ? j0 + transpose_tile : ncol;
+    for (int i0 = 0; i0 < nrow; i0 += transpose_tile) {
+      const int i1 = i0 + transpose_tile < nrow ? i0 + transpose_tile : nrow;
+      for (int j = j0; j < j1; ++j) {
+        for (int i = i0; i < i1; ++i) {
+          out(j, i) = x(i, j);
+        }
+      }
+    }
+  }
+}
+
+template <typename M, typename Out>
+void transpose_into(const M& x, Out& out, std::true_type /* raw pointer */) {
+  const int nrow = x.nrow();
+  const int ncol = x.ncol();
+  const R_xlen_t ld = leading_dim(x);
+  const auto* src = x.data_ptr();
+  auto* dst = out.data_ptr_writable();
+  if (src == nullptr || dst == nullptr) {
+    transpose_into(x, out, std::false_type{});
+    return;
+  }
+  // Square tiles keep both the rows read and the columns written in cache
+  for (int j0 = 0; j0 < ncol; j0 += transpose_tile) {
+    const int j1 = j0 + transpose_tile < ncol ? j0 + transpose_tile : ncol;
+    for (int i0 = 0; i0 < nrow; i0 += transpose_tile) {
+      const int i1 = i0 + transpose_tile < nrow ? i0 + transpose_tile : nrow;
+      for (int j = j0; j < j1; ++j) {
+        for (int i = i0; i < i1; ++i) {
+          dst[j + static_cast<R_xlen_t>(i) * ncol] =
+              src[i + static_cast<R_xlen_t>(j) * ld];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+// `t(x)`: a new matrix with rows and columns (and their dimnames) swapped, copied in
+// cache-sized square tiles
+template <typename V, typename T, typename S>
+matrix<writable::r_vector<typename V::scalar_type>,
+       typename writable::r_vector<typename V::scalar_type>::reference, S>
+transpose(const matrix<V, T, S>& x) {
+  using scalar_type = typename V::scalar_type;
+  using underlying_type = typename V::underlying_type;
+  matrix<writable::r_vector<scalar_type>,
+         typename writable::r_vector<scalar_type>::reference, S>
+      out(x.ncol(), x.nrow());
+
+  // Strings need the write barrier, so they go through the element proxies
+  detail::transpose_into(
+      x, out,
+      std::integral_constant<bool, !std::is_same<underlying_type, SEXP>::value>{});
+
+  SEXP dimnames = Rf_getAttrib(x.data(), R_DimNamesSymbol);
+  if (dimnames != R_NilValue) {
+    SEXP swapped = PROTECT(safe[Rf_allocVector](VECSXP, 2));
+    SET_VECTOR_ELT(swapped, 0, VECTOR_ELT(dimnames, 1));
+    SET_VECTOR_ELT(swapped, 1, VECTOR_ELT(dimnames, 0));
+    SEXP names = Rf_getAttrib(dimnames, R_NamesSymbol);
+    if (names != R_NilValue) {
+      SEXP swapped_names = PROTECT(safe[Rf_allocVector](STRSXP, 2));
+      SET_STRING_ELT(swapped_names, 0, STRING_ELT(names, 1));
+      SET_STRING_ELT(swapped_names, 1, STRING_ELT(names, 0));
+      Rf_setAttrib(swapped, R_NamesSymbol, swapped_names);
+      UNPROTECT(1);
+    }
+    Rf_setAttrib(out.data(), R_DimNamesSymbol, swapped);
+    UNPROTECT(1);
+  }
+
+  return out;
+}
+
+// `t(x)` for a block, without dimnames
+template <typename M>
+matrix<writable::r_vector<typename M::scalar_type>,
+       typename writable::r_vector<typename M::scalar_type>::reference, by_column>
+transpose(const matrix_block<M>& x) {
+  using scalar_type = typename M::scalar_type;
+  using underlying_type = typename M::underlying_type;
+  matrix<writable::r_vector<scalar_type>,
+         typename writable::r_vector<scalar_type>::reference, by_column>
+      out(x.ncol(), x.nrow());
+  detail::transpose_into(
+      x, out,
+      std::integral_constant<bool, !std::is_same<underlying_type, SEXP>::value>{});
+  return out;
+}
+
 }  // namespace cpp4r
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstddef>        // for size_t
+#include <iterator>       // for next, prev
+#include <limits>         // for numeric_limits
+#include <list>           // for list
+#include <type_traits>    // for declval, true_type, false_type
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move, forward
+
+#include "cpp4r/R.hpp"         // for SEXP, R_NilValue
+#include "cpp4r/protect.hpp"   // for stop
+#include "cpp4r/weak_ref.hpp"  // for weak_ref
+
+// Memoizes C++ results per R object, across `.Call`s.
+//
+// `memo_cache<Key, Value>` maps a reference object (an environment or an external
+// pointer, or anything that converts to one) to a C++ value, such as an index or a
+// factorization computed from it. It is meant to live in a `static`, so the work is
+// done once per object rather than once per call:
+//
+//   static cpp4r::memo_cache<cpp4r::environment, index> cache(100, 64 << 20);
+//   const index& idx = cache.get_or_compute(env, [](SEXP env) { return index(env); });
+//
+// Each entry holds its key through a `weak_ref`, so the cache never keeps an object
+// alive. When a key is collected its finalizer marks the cache as stale, and the entry
+// is dropped on the next lookup or insertion (`purge()` does it right away). Entries
+// that are evicted or erased while their key is alive finalize their `weak_ref` at once,
+// so R doesn't keep one weak reference per miss until the key dies. Entries
+// are also evicted, least recently used first, to stay within both a number of entries
+// and a number of bytes. The size of a value is `sizeof(Value)`, plus its elements for
+// containers with `size()` and `value_type`; pass a `Size` functor to measure it
+// differently.
+//
+// Values must not refer back to their key (e.g. a `sexp` of the key), or it can never
+// be collected. References returned by the cache stay valid until the next insertion,
+// `purge()`, `erase()` or `clear()`.
+
+namespace cpp4r {
+
+namespace detail {
+
+// Number of memoization keys collected so far in this process
+inline std::size_t& memo_collected() {
+  static std::size_t collected = 0;
+  return collected;
+}
+
+// Set while the cache runs the finalizer of a key it drops, which isn't a collection
+inline bool& memo_dropping() {
+  static bool dropping = false;
+  return dropping;
+}
+
+inline void memo_on_collect(SEXP) {
+  if (!memo_dropping()) {
+    ++memo_collected();
+  }
+}
+
+template <typename T, typename = void>
+struct memo_has_size : std::false_type {};
+
+template <typename T>
+struct memo_has_size<T, decltype((void)std::declval<const T&>().size(),
+                                 (void)sizeof(typename T::value_type))>
+    : std::true_type {};
+
+template <typename T>
+std::size_t memo_elements_size(const T& value, std::true_type) {
+  return value.size() * sizeof(typename T::value_type);
+}
+
+template <typename T>
+std::size_t memo_elements_size(const T&, std::false_type) {
+  return 0;
+}
+
+}  // namespace detail
+
+template <typename Value>
+struct memo_size {
+  std::size_t operator()(const Value& value) const {
+    return sizeof(Value) +
+           detail::memo_elements_size(value, detail::memo_has_size<Value>{});
+  }
+};
+
+template <typename Key, typename Value, typename Size = memo_size<Value>>
+class memo_cache {
+  struct entry {
+    SEXP key;
+    weak_ref ref;
+    Value value;
+    std::size_t bytes;
+  };
+
+  using entries = std::list<entry>;
+
+  entries entries_;  // most recently used first
+  std::unordered_map<SEXP, typename entries::iterator> index_;
+  std::size_t max_entries_;
+  std::size_t max_bytes_;
+  std::size_t bytes_ = 0;
+  std::size_t collected_ = detail::memo_collected();
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  std::size_t evictions_ = 0;
+  Size size_;
+
+  // Running the finalizer of a live key takes its weak reference off R's list of weak
+  // references at the next collection, rather than when the key is collected
+  static void release(entry& e) {
+    if (e.ref.alive()) {
+      detail::memo_dropping() = true;
+      e.ref.run_finalizer();
+      detail::memo_dropping() = false;
+    }
+  }
+
+  void drop(typename entries::iterator it) {
+    release(*it);
+    bytes_ -= it->bytes;
+    index_.erase(it->key);
+    entries_.erase(it);
+  }
+
+  // Drops collected entries if any key was collected since the last check
+  void purge_if_stale() {
+    if (collected_ != detail::memo_collected()) {
+      purge();
+    }
+  }
+
+  // Evicts from the least recently used end, keeping the most recent entry
+  void shrink() {
+    while (entries_.size() > 1 &&
+           (entries_.size() > max_entries_ || bytes_ > max_bytes_)) {
+      drop(std::prev(entries_.end()));
+      ++evictions_;
+    }
+  }
+
+ public:
+  // A cache of at most `max_entries` values using at most `max_bytes` bytes
+  explicit memo_cache(std::size_t max_entries,
+                      std::size_t max_bytes = std::numeric_limits<std::size_t>::max(),
+                      Size size = Size())
+      : max_entries_(max_entries), max_bytes_(max_bytes), size_(std::move(size)) {
+    if (max_entries_ == 0) {
+      stop("A memoization cache needs room for at least one entry");
+    }
+  }
+
+  memo_cache(const memo_cache&) = delete;
+  memo_cache& operator=(const memo_cache&) = delete;
+
+  // The value cached for `key`, or `nullptr`. Counts a hit or a miss.
+  Value* find(const Key& key) {
+    purge_if_stale();
+    SEXP k = key;
+    auto it = index_.find(k);
+    if (it == index_.end() || it->second->ref.key() != k) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->value;
+  }
+
+  // Caches `value` for `key`, replacing any value it had, and evicts what no longer fits
+  Value& insert(const Key& key, Value value) {
+    purge_if_stale();
+    SEXP k = key;
+    auto it = index_.find(k);
+    if (it != index_.end()) {
+      drop(it->second);
+    }
+    const std::size_t bytes = size_(value);
+    entries_.push_front(entry{
+        k, weak_ref(k, R_NilValue, detail::memo_on_collect), std::move(value), bytes});
+    index_.emplace(k, entries_.begin());
+    bytes_ += bytes;
+    shrink();
+    return entries_.front().value;
+  }
+
+  // The value cached for `key`, computing and caching `compute(key)` on a miss
+  template <typename F>
+  Value& get_or_compute(const Key& key, F&& compute) {
+    Value* found = find(key);
+    if (found != nullptr) {
+      return *found;
+    }
+    return insert(key, std::forward<F>(compute)(key));
+  }
+
+  // Removes the entry for `key`, if any
+  bool erase(const Key& key) {
+    auto it = index_.find(static_cast<SEXP>(key));
+    if (it == index_.end()) {
+      return false;
+    }
+    drop(it->second);
+    return true;
+  }
+
+  // Removes the entries whose key has been collected, returning how many there were
+  std::size_t purge() {
+    collected_ = detail::memo_collected();
+    std::size_t n = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      auto next = std::next(it);
+      if (!it->ref.alive()) {
+        drop(it);
+        ++n;
+      }
+      it = next;
+    }
+    return n;
+  }
+
+  void clear() {
+    for (entry& e : entries_) {
+      release(e);
+    }
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+  }
+
+  std::size_t size() const noexcept { return entries_.size(); }
+  std::size_t bytes() const noexcept { return bytes_; }
+  std::size_t max_entries() const noexcept { return max_entries_; }
+  std::size_t max_bytes() const noexcept { return max_bytes_; }
+
+  std::size_t hits() const noexcept { return hits_; }
+  std::size_t misses() const noexcept { return misses_; }
+  std::size_t evictions() const noexcept { return evictions_; }
+  void reset_counters() noexcept { hits_ = misses_ = evictions_ = 0; }
+};
+
+}  // namespace cpp4r
@@ -4,9 +4,10 @@
 
 #include <initializer_list>  // for initializer_list
 
-#include "cpp4r/R.hpp"     // for SEXP, SEXPREC, literals
-#include "cpp4r/as.hpp"    // for as_sexp
-#include "cpp4r/sexp.hpp"  // for sexp
+#include "cpp4r/R.hpp"       // for SEXP, SEXPREC, literals
+#include "cpp4r/as.hpp"      // for as_sexp
+#include "cpp4r/sexp.hpp"    // for sexp
+#include "cpp4r/symbol.hpp"  // for symbol
 
 namespace cpp4r {
 class named_arg {
@@ -16,6 +17,14 @@ class named_arg {
   template <typename T>
   explicit named_arg(const char* name, T value) : name_(name), value_(as_sexp(value)) {}
 
+  // Named by a symbol that is already installed
+  explicit named_arg(const symbol& name)
+      : name_(name.name()), tag_(name), value_(R_NilValue) {}
+
+  template <typename T>
+  explicit named_arg(const symbol& name, T value)
+      : name_(name.name()), tag_(name), value_(as_sexp(value)) {}
+
   named_arg& operator=(std::initializer_list<int> il) {
     value_ = as_sexp(il);
     return *this;
@@ -36,8 +45,12 @@ class named_arg {
   const char* name() const noexcept { return name_; }
   SEXP value() const noexcept { return value_; }
 
+  // The name as a symbol, installed here unless the argument was named by one
+  SEXP tag() const { return tag_ != R_NilValue ? tag_ : safe[Rf_install](name_); }
+
  private:
   const char* name_;
+  SEXP tag_ = R_NilValue;
   sexp value_;
 };
 
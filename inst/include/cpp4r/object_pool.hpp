@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>      // for size_t, nullptr_t
+#include <memory>       // for bad_weak_ptr, unique_ptr
+#include <new>          // for placement new
+#include <type_traits>  // for add_lvalue_reference
+#include <utility>      // for forward
+#include <vector>       // for vector
+
+#include "cpp4r/R.hpp"         // for SEXP, R_NilValue, R_MakeExternalPtr
+#include "cpp4r/protect.hpp"   // for safe, stop
+#include "cpp4r/r_vector.hpp"  // for type_error
+#include "cpp4r/sexp.hpp"      // for sexp
+
+// External pointers to C++ objects allocated from slabs.
+//
+// `external_pointer<T>` makes one heap allocation and registers one finalizer per
+// object, which adds up when millions of small handles are made. An `object_pool<T>`
+// instead constructs its objects in slabs of `SlabSize`, and registers a single
+// finalizer per slab. Every handle (a `pooled_pointer<T>`, an EXTPTRSXP) protects the
+// slab it points into, so the slab is finalized, destroying all of its objects in one
+// go, once no handle to any of them is left and the pool has moved on to a newer slab.
+//
+// The memory of an object is therefore only returned with the rest of its slab.
+// `pooled_pointer::reset()` destroys an object straight away; its slot is reused if its
+// slab is still the one the pool allocates from.
+//
+//   static cpp4r::object_pool<node> pool;
+//   cpp4r::pooled_pointer<node> p = pool.make(1.0, 2.0);
+
+namespace cpp4r {
+
+namespace detail {
+
+// The tag of the external pointer that owns a slab
+inline SEXP pool_slab_tag() {
+  static SEXP tag = safe[Rf_install]("cpp4r_object_pool_slab");
+  return tag;
+}
+
+template <typename T>
+class pool_slab {
+  struct alignas(T) slot {
+    unsigned char bytes[sizeof(T)];
+  };
+
+  std::unique_ptr<slot[]> slots_;
+  std::vector<bool> live_;
+  std::vector<std::size_t> free_;
+  std::size_t used_ = 0;
+
+ public:
+  explicit pool_slab(std::size_t size) : slots_(new slot[size]), live_(size, false) {}
+
+  pool_slab(const pool_slab&) = delete;
+  pool_slab& operator=(const pool_slab&) = delete;
+
+  ~pool_slab() {
+    for (std::size_t i = 0; i < used_; ++i) {
+      if (live_[i]) {
+        get(i)->~T();
+      }
+    }
+  }
+
+  T* get(std::size_t i) noexcept { return reinterpret_cast<T*>(slots_[i].bytes); }
+
+  // A slot that can take a new object, or `live_.size()` when the slab is full
+  std::size_t next() const noexcept { return free_.empty() ? used_ : free_.back(); }
+
+  template <typename... Args>
+  T* construct(std::size_t i, Args&&... args) {
+    T* out = new (slots_[i].bytes) T(std::forward<Args>(args)...);
+    live_[i] = true;
+    if (!free_.empty() && free_.back() == i) {
+      free_.pop_back();
+    } else {
+      ++used_;
+    }
+    return out;
+  }
+
+  void destroy(T* obj) {
+    const std::size_t i = static_cast<std::size_t>(
+        reinterpret_cast<slot*>(obj) - slots_.get());
+    live_[i] = false;
+    obj->~T();
+    free_.push_back(i);
+  }
+
+  static void finalize(SEXP token) {
+    pool_slab* slab = static_cast<pool_slab*>(R_ExternalPtrAddr(token));
+    if (slab == nullptr) {
+      return;
+    }
+    R_ClearExternalPtr(token);
+    delete slab;
+  }
+};
+
+}  // namespace detail
+
+template <typename T>
+class pooled_pointer {
+  sexp data_ = R_NilValue;
+
+  static SEXP valid_type(SEXP data) {
+    if (data == R_NilValue) {
+      return data;
+    }
+    if (detail::r_typeof(data) != EXTPTRSXP) {
+      throw type_error(EXTPTRSXP, detail::r_typeof(data));
+    }
+    SEXP slab = R_ExternalPtrProtected(data);
+    if (detail::r_typeof(slab) != EXTPTRSXP ||
+        R_ExternalPtrTag(slab) != detail::pool_slab_tag()) {
+      stop("Expected an external pointer made by an `object_pool`");
+    }
+    return data;
+  }
+
+ public:
+  using pointer = T*;
+
+  pooled_pointer() noexcept {}
+  pooled_pointer(std::nullptr_t) noexcept {}
+
+  // A handle made by an `object_pool<T>`. Copies share it, rather than duplicating it.
+  pooled_pointer(SEXP data) : data_(valid_type(data)) {}
+
+  operator SEXP() const noexcept { return data_; }
+
+  pointer get() const noexcept {
+    if (data_ == R_NilValue) {
+      return nullptr;
+    }
+    return static_cast<T*>(R_ExternalPtrAddr(data_));
+  }
+
+  typename std::add_lvalue_reference<T>::type operator*() const {
+    pointer addr = get();
+    if (addr == nullptr) {
+      throw std::bad_weak_ptr();
+    }
+    return *addr;
+  }
+
+  pointer operator->() const {
+    pointer addr = get();
+    if (addr == nullptr) {
+      throw std::bad_weak_ptr();
+    }
+    return addr;
+  }
+
+  // Destroys the object now, for every copy of the handle, instead of with its slab
+  void reset() {
+    pointer addr = get();
+    if (addr == nullptr) {
+      return;
+    }
+    R_ClearExternalPtr(data_);
+    auto* slab = static_cast<detail::pool_slab<T>*>(
+        R_ExternalPtrAddr(R_ExternalPtrProtected(data_)));
+    slab->destroy(addr);
+  }
+
+  operator bool() const noexcept { return get() != nullptr; }
+};
+
+template <typename T, std::size_t SlabSize = 256>
+class object_pool {
+  static_assert(SlabSize > 0, "A slab needs room for at least one object");
+
+  // The slab being allocated from, and its external pointer
+  sexp token_ = R_NilValue;
+  detail::pool_slab<T>* slab_ = nullptr;
+  std::size_t slabs_ = 0;
+
+  void new_slab() {
+    sexp token =
+        safe[R_MakeExternalPtr](nullptr, detail::pool_slab_tag(), R_NilValue);
+    safe[R_RegisterCFinalizerEx](token, detail::pool_slab<T>::finalize, TRUE);
+    slab_ = new detail::pool_slab<T>(SlabSize);
+    R_SetExternalPtrAddr(token, slab_);
+    token_ = token;
+    ++slabs_;
+  }
+
+ public:
+  object_pool() = default;
+  object_pool(const object_pool&) = delete;
+  object_pool& operator=(const object_pool&) = delete;
+
+  // Constructs a `T` from `args` in the current slab, starting a new one if it is full
+  template <typename... Args>
+  pooled_pointer<T> make(Args&&... args) {
+    if (slab_ == nullptr || slab_->next() == SlabSize) {
+      new_slab();
+    }
+    T* obj = slab_->construct(slab_->next(), std::forward<Args>(args)...);
+    SEXP out;
+    try {
+      out = safe[R_MakeExternalPtr](obj, R_NilValue, token_);
+    } catch (...) {
+      slab_->destroy(obj);
+      throw;
+    }
+    return pooled_pointer<T>(out);
+  }
+
+  // Number of slabs allocated so far
+  std::size_t slabs() const noexcept { return slabs_; }
+  static constexpr std::size_t slab_size() noexcept { return SlabSize; }
+};
+
+}  // namespace cpp4r
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <csetjmp>    // for longjmp, setjmp, jmp_buf
+#include <cstring>    // for strncpy
 #include <exception>  // for exception
 #include <stdexcept>  // for std::runtime_error
 #include <string>     // for string, basic_string
@@ -94,6 +95,33 @@ unwind_protect(Fun&& code) {
 
 namespace detail {
 
+// The other way around from `unwind_protect()`: runs `code` from a callback that R
+// calls, such as an ALTREP method or a serialization stream, turning C++ exceptions
+// into R errors so they never cross R's C frames
+template <typename Fun>
+SEXP r_callback(Fun&& code) {
+  SEXP err = R_NilValue;
+  char buf[8192] = "";
+  try {
+    return code();
+  } catch (unwind_exception& e) {
+    err = e.token;
+  } catch (std::exception& e) {
+    std::strncpy(buf, e.what(), sizeof(buf) - 1);
+  } catch (...) {
+    std::strncpy(buf, "C++ error (unknown cause)", sizeof(buf) - 1);
+  }
+  if (buf[0] != '\0') {
+    Rf_errorcall(R_NilValue, "%s", buf);
+  }
+  R_ContinueUnwind(err);
+  return R_NilValue;
+}
+
+}  // namespace detail
+
+namespace detail {
+
 // C++11: custom index_sequence / make_index_sequence (added to <utility> in C++14)
 #if !CPP4R_HAS_CXX14
 template <size_t...>
@@ -119,6 +147,17 @@ using std::index_sequence;
 using std::make_index_sequence;
 #endif
 
+#if CPP4R_HAS_CXX20
+// A string literal as a template argument, e.g. `template <fixed_string Name>`
+template <std::size_t N>
+struct fixed_string {
+  char value[N];
+  constexpr fixed_string(const char (&str)[N]) {
+    for (std::size_t i = 0; i < N; ++i) value[i] = str[i];
+  }
+};
+#endif
+
 // C++11/14: custom apply() (std::apply not available until C++17 in <tuple>)
 #if !CPP4R_HAS_CXX17
 template <typename F, typename... Aref, size_t... I>
@@ -38,8 +38,16 @@ class r_bool {
   bool operator==(Rboolean rhs) const noexcept { return operator==(r_bool(rhs)); }
   bool operator==(int rhs) const noexcept { return operator==(r_bool(rhs)); }
 
+  // FALSE < TRUE < NA, as in `order()`
+  static bool less(int lhs, int rhs) noexcept { return rank(lhs) < rank(rhs); }
+
+  friend bool operator<(const r_bool& lhs, const r_bool& rhs) noexcept {
+    return less(lhs.value_, rhs.value_);
+  }
+
  private:
   static constexpr int na = std::numeric_limits<int>::min();
+  static constexpr int rank(int value) noexcept { return value == na ? 2 : value; }
   static constexpr int from_int(int value) noexcept {
     return (value == static_cast<int>(FALSE)) ? FALSE
            : (value == static_cast<int>(na))  ? na
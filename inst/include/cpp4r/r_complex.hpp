@@ -67,6 +67,20 @@ class r_complex {
 
   bool operator!=(const r_complex& rhs) const noexcept { return !(*this == rhs); }
 
+  // Real parts first, then imaginary parts, with NA and NaN last, as in `order()`
+  static bool less(const Rcomplex& lhs, const Rcomplex& rhs) noexcept {
+    const bool lhs_na = ISNAN(lhs.r) || ISNAN(lhs.i);
+    const bool rhs_na = ISNAN(rhs.r) || ISNAN(rhs.i);
+    if (lhs_na || rhs_na) {
+      return !lhs_na;
+    }
+    return lhs.r < rhs.r || (lhs.r == rhs.r && lhs.i < rhs.i);
+  }
+
+  friend bool operator<(const r_complex& lhs, const r_complex& rhs) noexcept {
+    return less(lhs, rhs);
+  }
+
   r_complex& operator+=(const r_complex& rhs) {
     *this = r_complex(real() + rhs.real(), imag() + rhs.imag());
     return *this;
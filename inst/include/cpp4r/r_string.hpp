@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>  // for strcmp
 #include <string>
 #include <type_traits>
 
@@ -84,6 +85,26 @@ class r_string {
 
   CPP4R_NODISCARD R_xlen_t size() const noexcept { return Rf_xlength(data_); }
 
+  // Byte-wise ("C" locale) ordering of the UTF-8 representations with `NA` last, as in
+  // `order(method = "radix")`. Identical CHARSXPs short-circuit on the pointer.
+  static bool less(SEXP lhs, SEXP rhs) {
+    if (lhs == rhs || lhs == NA_STRING) {
+      return false;
+    }
+    if (rhs == NA_STRING) {
+      return true;
+    }
+    void* vmax = vmaxget();
+    const bool result =
+        std::strcmp(Rf_translateCharUTF8(lhs), Rf_translateCharUTF8(rhs)) < 0;
+    vmaxset(vmax);
+    return result;
+  }
+
+  friend bool operator<(const r_string& lhs, const r_string& rhs) {
+    return less(lhs, rhs);
+  }
+
  private:
   sexp data_ = R_NilValue;
 };
@@ -8,7 +8,7 @@
 #include <cstring>           // for memcpy
 #include <exception>         // for exception
 #include <initializer_list>  // for initializer_list
-#include <iterator>          // for forward_iterator_tag
+#include <iterator>          // for random_access_iterator_tag
 #include <stdexcept>         // for out_of_range
 #include <string>            // for string, basic_string
 #include <type_traits>       // for decay, is_same, and enable_if
@@ -39,6 +39,15 @@ template <>
 struct use_raw_pointer<int> : std::true_type {};
 // Note: r_bool, r_string, r_complex, and list types still need generic iterators
 // because they require special handling (proxies, ALTREP awareness, etc.)
+
+// Length of the ALTREP region buffer carried by generic iterators. Strings and lists
+// are never region-buffered, so they keep a single slot and stay cheap to copy.
+template <typename T>
+struct iterator_buffer_size : std::integral_constant<std::size_t, 64> {};
+template <>
+struct iterator_buffer_size<r_string> : std::integral_constant<std::size_t, 1> {};
+template <>
+struct iterator_buffer_size<SEXP> : std::integral_constant<std::size_t, 1> {};
 }  // namespace traits
 
 namespace writable {
@@ -130,15 +139,14 @@ class r_vector {
     // Iterator references:
     // https://cplusplus.com/reference/iterator/
     // https://stackoverflow.com/questions/8054273/how-to-implement-an-stl-style-iterator-and-avoid-common-pitfalls
-    // It seems like our iterator doesn't fully implement everything for
-    // `random_access_iterator_tag` (like an `[]` operator, for example). If we discover
-    // issues with it, we probably need to add more methods.
+    // Reads of ALTREP vectors go through a small region buffer; random jumps that land
+    // outside of it (`+=`, `[]`) refill it or fall back to per-element access.
    private:
     const r_vector* data_;
     R_xlen_t pos_;
     // Buffer used for ALTREP region reads. Keep this small to avoid large
     // stack frames for iterator objects. Tunable via BUF_CAP.
-    static constexpr std::size_t BUF_CAP = 64;
+    static constexpr std::size_t BUF_CAP = traits::iterator_buffer_size<T>::value;
     // Don't attempt ALTREP region buffering for tiny vectors (cheap per-elt
     // access is preferable). Tunable threshold.
     static constexpr R_xlen_t BUF_THRESHOLD = static_cast<R_xlen_t>(256);
@@ -150,28 +158,45 @@ class r_vector {
     using difference_type = ptrdiff_t;
     using value_type = T;
     using pointer = T*;
-    using reference = T&;
+    // Elements are materialized on dereference, so `reference` is a value
+    using reference = T;
     using iterator_category = std::random_access_iterator_tag;
 
     generic_const_iterator(const r_vector* data, R_xlen_t pos);
 
-    generic_const_iterator operator+(R_xlen_t pos);
+    generic_const_iterator operator+(R_xlen_t pos) const;
+    generic_const_iterator operator-(R_xlen_t pos) const;
     ptrdiff_t operator-(const generic_const_iterator& other) const;
 
+    friend generic_const_iterator operator+(R_xlen_t lhs,
+                                            const generic_const_iterator& rhs) {
+      return rhs + lhs;
+    }
+
     generic_const_iterator& operator++();
     generic_const_iterator& operator--();
+    generic_const_iterator operator++(int);
+    generic_const_iterator operator--(int);
 
     generic_const_iterator& operator+=(R_xlen_t pos);
     generic_const_iterator& operator-=(R_xlen_t pos);
 
     bool operator!=(const generic_const_iterator& other) const;
     bool operator==(const generic_const_iterator& other) const;
+    bool operator<(const generic_const_iterator& other) const;
+    bool operator>(const generic_const_iterator& other) const;
+    bool operator<=(const generic_const_iterator& other) const;
+    bool operator>=(const generic_const_iterator& other) const;
 
     T operator*() const;
+    T operator[](R_xlen_t pos) const;
 
     friend class writable::r_vector<T>;
 
    private:
+    // Used by the writable iterator, which must never read through a buffered copy
+    generic_const_iterator(const r_vector* data, R_xlen_t pos, bool buffered);
+
     // Implemented in specialization
     static bool use_buf(bool is_altrep);
     void fill_buf(R_xlen_t pos);
@@ -327,30 +352,39 @@ class r_vector : public cpp4r::r_vector<T> {
   class generic_iterator : public cpp4r::r_vector<T>::generic_const_iterator {
    private:
     using cpp4r::r_vector<T>::generic_const_iterator::data_;
-    using cpp4r::r_vector<T>::generic_const_iterator::block_start_;
     using cpp4r::r_vector<T>::generic_const_iterator::pos_;
-    using cpp4r::r_vector<T>::generic_const_iterator::buf_;
-    using cpp4r::r_vector<T>::generic_const_iterator::length_;
-    using cpp4r::r_vector<T>::generic_const_iterator::use_buf;
-    using cpp4r::r_vector<T>::generic_const_iterator::fill_buf;
 
    public:
+    // `value_type` is the element type so that algorithms can hold temporaries
+    // (`value_type tmp = std::move(*it)`); dereferencing yields a `proxy` that writes
+    // through to the vector.
     using difference_type = ptrdiff_t;
-    using value_type = proxy;
+    using value_type = T;
     using pointer = proxy*;
-    using reference = proxy&;
-    using iterator_category = std::forward_iterator_tag;
+    using reference = proxy;
+    using iterator_category = std::random_access_iterator_tag;
 
     generic_iterator(const r_vector* data, R_xlen_t pos);
 
     generic_iterator& operator++();
+    generic_iterator& operator--();
+    generic_iterator operator++(int);
+    generic_iterator operator--(int);
 
     proxy operator*() const;
+    proxy operator[](R_xlen_t pos) const;
 
     using cpp4r::r_vector<T>::generic_const_iterator::operator!=;
+    using cpp4r::r_vector<T>::generic_const_iterator::operator-;
 
     generic_iterator& operator+=(R_xlen_t rhs);
-    generic_iterator operator+(R_xlen_t rhs);
+    generic_iterator& operator-=(R_xlen_t rhs);
+    generic_iterator operator+(R_xlen_t rhs) const;
+    generic_iterator operator-(R_xlen_t rhs) const;
+
+    friend generic_iterator operator+(R_xlen_t lhs, const generic_iterator& rhs) {
+      return rhs + lhs;
+    }
   };
 
   using iterator = typename std::conditional<traits::use_raw_pointer<T>::value, T*,
@@ -449,6 +483,26 @@ class r_vector : public cpp4r::r_vector<T> {
 
     operator T() const;
 
+    // Exchanges the referenced elements (not the proxies), so `std::iter_swap()` and
+    // `std::sort()` work through writable iterators
+    friend void swap(proxy lhs, proxy rhs) {
+      const underlying_type tmp = lhs.get();
+      lhs.set(rhs.get());
+      rhs.set(tmp);
+    }
+
+    // Ordering on the stored elements, without materializing `T`; requires
+    // `T::less(underlying_type, underlying_type)`
+    friend bool operator<(const proxy& lhs, const proxy& rhs) {
+      return T::less(lhs.get(), rhs.get());
+    }
+    friend bool operator<(const proxy& lhs, const T& rhs) {
+      return T::less(lhs.get(), static_cast<underlying_type>(rhs));
+    }
+    friend bool operator<(const T& lhs, const proxy& rhs) {
+      return T::less(static_cast<underlying_type>(lhs), rhs.get());
+    }
+
    private:
     underlying_type get() const;
     void set(underlying_type x);
@@ -425,6 +425,17 @@ r_vector<T>::generic_const_iterator::generic_const_iterator(const r_vector* data
   }
 }
 
+template <typename T>
+r_vector<T>::generic_const_iterator::generic_const_iterator(const r_vector* data,
+                                                            R_xlen_t pos, bool buffered)
+    : data_(data), pos_(pos), buf_() {
+  if (buffered && use_buf(data_->is_altrep()) &&
+      data_->size() >
+          static_cast<R_xlen_t>(r_vector<T>::generic_const_iterator::BUF_THRESHOLD)) {
+    fill_buf(pos);
+  }
+}
+
 template <typename T>
 CPP4R_ALWAYS_INLINE typename r_vector<T>::generic_const_iterator&
 r_vector<T>::generic_const_iterator::operator++() {
@@ -444,19 +455,25 @@ r_vector<T>::generic_const_iterator::operator++() {
   return *this;
 }
 
+// Moving backwards refills the buffer with the window that ends at `pos_`, random
+// jumps refill it whenever `pos_` lands outside of the loaded window.
 template <typename T>
 inline typename r_vector<T>::generic_const_iterator&
 r_vector<T>::generic_const_iterator::operator--() {
   --pos_;
 #if CPP4R_HAS_CXX20
-  if (length_ > 0 && pos_ >= 0 && pos_ < block_start_) [[unlikely]] {
-    fill_buf(std::max(0_xl, pos_ - static_cast<R_xlen_t>(
-                                       r_vector<T>::generic_const_iterator::BUF_CAP)));
+  if (length_ > 0 && pos_ >= 0 && (pos_ < block_start_ || pos_ >= block_start_ + length_))
+      [[unlikely]] {
+    fill_buf(std::max(0_xl, pos_ + 1 -
+                                static_cast<R_xlen_t>(
+                                    r_vector<T>::generic_const_iterator::BUF_CAP)));
   }
 #else
-  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= 0 && pos_ < block_start_)) {
-    fill_buf(std::max(0_xl, pos_ - static_cast<R_xlen_t>(
-                                       r_vector<T>::generic_const_iterator::BUF_CAP)));
+  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= 0 &&
+                     (pos_ < block_start_ || pos_ >= block_start_ + length_))) {
+    fill_buf(std::max(0_xl, pos_ + 1 -
+                                static_cast<R_xlen_t>(
+                                    r_vector<T>::generic_const_iterator::BUF_CAP)));
   }
 #endif
   return *this;
@@ -467,11 +484,13 @@ inline typename r_vector<T>::generic_const_iterator&
 r_vector<T>::generic_const_iterator::operator+=(R_xlen_t i) {
   pos_ += i;
 #if CPP4R_HAS_CXX20
-  if (length_ > 0 && pos_ >= block_start_ + length_) [[unlikely]] {
+  if (length_ > 0 && pos_ >= 0 && (pos_ < block_start_ || pos_ >= block_start_ + length_))
+      [[unlikely]] {
     fill_buf(pos_);
   }
 #else
-  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= block_start_ + length_)) {
+  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= 0 &&
+                     (pos_ < block_start_ || pos_ >= block_start_ + length_))) {
     fill_buf(pos_);
   }
 #endif
@@ -483,14 +502,18 @@ inline typename r_vector<T>::generic_const_iterator&
 r_vector<T>::generic_const_iterator::operator-=(R_xlen_t i) {
   pos_ -= i;
 #if CPP4R_HAS_CXX20
-  if (length_ > 0 && pos_ < block_start_) [[unlikely]] {
-    fill_buf(std::max(0_xl, pos_ - static_cast<R_xlen_t>(
-                                       r_vector<T>::generic_const_iterator::BUF_CAP)));
+  if (length_ > 0 && pos_ >= 0 && (pos_ < block_start_ || pos_ >= block_start_ + length_))
+      [[unlikely]] {
+    fill_buf(std::max(0_xl, pos_ + 1 -
+                                static_cast<R_xlen_t>(
+                                    r_vector<T>::generic_const_iterator::BUF_CAP)));
   }
 #else
-  if (CPP4R_UNLIKELY(length_ > 0 && pos_ < block_start_)) {
-    fill_buf(std::max(0_xl, pos_ - static_cast<R_xlen_t>(
-                                       r_vector<T>::generic_const_iterator::BUF_CAP)));
+  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= 0 &&
+                     (pos_ < block_start_ || pos_ >= block_start_ + length_))) {
+    fill_buf(std::max(0_xl, pos_ + 1 -
+                                static_cast<R_xlen_t>(
+                                    r_vector<T>::generic_const_iterator::BUF_CAP)));
   }
 #endif
   return *this;
@@ -516,12 +539,60 @@ inline ptrdiff_t r_vector<T>::generic_const_iterator::operator-(
 
 template <typename T>
 inline typename r_vector<T>::generic_const_iterator
-r_vector<T>::generic_const_iterator::operator+(R_xlen_t rhs) {
+r_vector<T>::generic_const_iterator::operator+(R_xlen_t rhs) const {
   auto it = *this;
   it += rhs;
   return it;
 }
 
+template <typename T>
+inline typename r_vector<T>::generic_const_iterator
+r_vector<T>::generic_const_iterator::operator-(R_xlen_t rhs) const {
+  auto it = *this;
+  it -= rhs;
+  return it;
+}
+
+template <typename T>
+inline typename r_vector<T>::generic_const_iterator
+r_vector<T>::generic_const_iterator::operator++(int) {
+  auto it = *this;
+  ++(*this);
+  return it;
+}
+
+template <typename T>
+inline typename r_vector<T>::generic_const_iterator
+r_vector<T>::generic_const_iterator::operator--(int) {
+  auto it = *this;
+  --(*this);
+  return it;
+}
+
+template <typename T>
+inline bool r_vector<T>::generic_const_iterator::operator<(
+    const r_vector::generic_const_iterator& other) const {
+  return pos_ < other.pos_;
+}
+
+template <typename T>
+inline bool r_vector<T>::generic_const_iterator::operator>(
+    const r_vector::generic_const_iterator& other) const {
+  return pos_ > other.pos_;
+}
+
+template <typename T>
+inline bool r_vector<T>::generic_const_iterator::operator<=(
+    const r_vector::generic_const_iterator& other) const {
+  return pos_ <= other.pos_;
+}
+
+template <typename T>
+inline bool r_vector<T>::generic_const_iterator::operator>=(
+    const r_vector::generic_const_iterator& other) const {
+  return pos_ >= other.pos_;
+}
+
 template <typename T>
 inline typename r_vector<T>::const_iterator r_vector<T>::find(
     const r_string& name) const {
@@ -600,6 +671,17 @@ CPP4R_ALWAYS_INLINE T r_vector<T>::generic_const_iterator::operator*() const {
   return data_->operator[](pos_);
 }
 
+template <typename T>
+inline T r_vector<T>::generic_const_iterator::operator[](R_xlen_t pos) const {
+  // Serve the offset from the region buffer when it is already loaded; otherwise
+  // read the single element instead of refilling the buffer of a copy.
+  const R_xlen_t i = pos_ + pos;
+  if (length_ > 0 && i >= block_start_ && i < block_start_ + length_) {
+    return static_cast<T>(buf_[i - block_start_]);
+  }
+  return data_->operator[](i);
+}
+
 template <typename T>
 inline void r_vector<T>::generic_const_iterator::fill_buf(R_xlen_t pos) {
   using namespace cpp4r::literals;
@@ -613,6 +695,15 @@ inline void r_vector<T>::generic_const_iterator::fill_buf(R_xlen_t pos) {
     return;
   }
 
+  // Past-the-end positions are never dereferenced: keep the current window (or the
+  // disabled state of a freshly constructed `end()`) instead of loading nothing.
+  if (pos >= data_->size()) {
+    if (length_ == 0) {
+      block_start_ = pos;
+    }
+    return;
+  }
+
   // Limit region size to the iterator buffer capacity (BUF_CAP) to avoid
   // overrunning the buffer and to keep fills predictable.
   length_ = static_cast<R_xlen_t>(
@@ -840,66 +840,90 @@ CPP4R_ALWAYS_INLINE void r_vector<T>::proxy::set(
 #endif
 }
 
+// Writable iterators never read through the ALTREP region buffer: a buffered copy
+// would go stale as soon as another iterator (or this one) writes to the vector, which
+// random-access algorithms such as `std::sort()` do constantly. Non-ALTREP vectors are
+// accessed through `data_p_`; ALTREP ones through `get_elt()`/`set_elt()`.
 template <typename T>
 r_vector<T>::generic_iterator::generic_iterator(const r_vector* data, R_xlen_t pos)
-    : r_vector::generic_const_iterator(data, pos) {}
+    : r_vector::generic_const_iterator(data, pos, false) {}
 
 template <typename T>
-inline typename r_vector<T>::generic_iterator&
+CPP4R_ALWAYS_INLINE typename r_vector<T>::generic_iterator&
 r_vector<T>::generic_iterator::operator++() {
   ++pos_;
-  // Use `length_ > 0` (a cheap field read) rather than `use_buf(data_->is_altrep())`
-  // (a virtual-style call) — same semantics since fill_buf only sets length_ > 0
-  // when buffering is active. Matches the optimization already in the const version.
-#if CPP4R_HAS_CXX20
-  if (length_ > 0 && pos_ >= block_start_ + length_) [[unlikely]] {
-    fill_buf(pos_);
-  }
-#else
-  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= block_start_ + length_)) {
-    fill_buf(pos_);
-  }
-#endif
   return *this;
 }
 
 template <typename T>
-inline typename r_vector<T>::proxy r_vector<T>::generic_iterator::operator*() const {
-  if (use_buf(data_->is_altrep())) {
-    return proxy(
-        data_->data(), pos_,
-        const_cast<typename r_vector::underlying_type*>(&buf_[pos_ - block_start_]),
-        true);
-  } else {
-    return proxy(data_->data(), pos_,
-                 data_->data_p_ != nullptr ? &data_->data_p_[pos_] : nullptr, false);
-  }
+CPP4R_ALWAYS_INLINE typename r_vector<T>::generic_iterator&
+r_vector<T>::generic_iterator::operator--() {
+  --pos_;
+  return *this;
+}
+
+template <typename T>
+inline typename r_vector<T>::generic_iterator r_vector<T>::generic_iterator::operator++(
+    int) {
+  auto it = *this;
+  ++pos_;
+  return it;
+}
+
+template <typename T>
+inline typename r_vector<T>::generic_iterator r_vector<T>::generic_iterator::operator--(
+    int) {
+  auto it = *this;
+  --pos_;
+  return it;
+}
+
+template <typename T>
+CPP4R_ALWAYS_INLINE typename r_vector<T>::proxy
+r_vector<T>::generic_iterator::operator*() const {
+  return proxy(data_->data(), pos_,
+               data_->data_p_ != nullptr ? &data_->data_p_[pos_] : nullptr,
+               data_->is_altrep_);
+}
+
+template <typename T>
+inline typename r_vector<T>::proxy r_vector<T>::generic_iterator::operator[](
+    R_xlen_t pos) const {
+  const R_xlen_t i = pos_ + pos;
+  return proxy(data_->data(), i, data_->data_p_ != nullptr ? &data_->data_p_[i] : nullptr,
+               data_->is_altrep_);
 }
 
 template <typename T>
 inline typename r_vector<T>::generic_iterator& r_vector<T>::generic_iterator::operator+=(
     R_xlen_t rhs) {
   pos_ += rhs;
-#if CPP4R_HAS_CXX20
-  if (length_ > 0 && pos_ >= block_start_ + length_) [[unlikely]] {
-    fill_buf(pos_);
-  }
-#else
-  if (CPP4R_UNLIKELY(length_ > 0 && pos_ >= block_start_ + length_)) {
-    fill_buf(pos_);
-  }
-#endif
   return *this;
 }
 
 template <typename T>
-inline typename r_vector<T>::generic_iterator r_vector<T>::generic_iterator::operator+(
+inline typename r_vector<T>::generic_iterator& r_vector<T>::generic_iterator::operator-=(
     R_xlen_t rhs) {
+  pos_ -= rhs;
+  return *this;
+}
+
+template <typename T>
+inline typename r_vector<T>::generic_iterator r_vector<T>::generic_iterator::operator+(
+    R_xlen_t rhs) const {
   auto it = *this;
   it += rhs;
   return it;
 }
 
+template <typename T>
+inline typename r_vector<T>::generic_iterator r_vector<T>::generic_iterator::operator-(
+    R_xlen_t rhs) const {
+  auto it = *this;
+  it -= rhs;
+  return it;
+}
+
 /// Compared to `Rf_xlengthgets()`:
 /// - This copies over attributes with `Rf_copyMostAttrib()`, which is important when we
 ///   truncate right before returning from the `SEXP` operator.
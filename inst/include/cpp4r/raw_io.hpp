@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <cstring>      // for memcpy
+#include <string>       // for string
+#include <type_traits>  // for is_trivially_copyable
+#include <vector>       // for vector
+
+#include "cpp4r/R.hpp"        // for SEXP, RAW, Rbyte
+#include "cpp4r/protect.hpp"  // for safe, stop
+#include "cpp4r/sexp.hpp"     // for sexp
+
+// Binary encoding straight into, and out of, raw vectors.
+//
+// A `raw_writer` writes into the memory of a RAWSXP, or only counts the bytes it would
+// write. `encode_raws(x)` uses both: it encodes `x` once to learn its size, allocates a
+// raw vector of exactly that size and encodes `x` again into it, so the bytes are never
+// staged in a `std::vector` or copied to trim spare capacity. `raw_reader` reads them
+// back.
+//
+// Values are written in the native byte order and width. Strings and vectors are
+// prefixed with their length as a 64-bit integer.
+
+namespace cpp4r {
+
+class raw_writer {
+  Rbyte* data_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+
+ public:
+  // A writer that only counts bytes
+  raw_writer() = default;
+
+  // A writer into the raw vector `out`, which must be large enough for everything
+  // written to it
+  explicit raw_writer(SEXP out)
+      : data_(RAW(out)), capacity_(static_cast<std::size_t>(Rf_xlength(out))) {}
+
+  void write(const void* data, std::size_t n) {
+    if (data_ != nullptr) {
+      if (n > capacity_ - size_) {
+        stop("Can't write %llu bytes at offset %llu of a raw vector of %llu bytes",
+             static_cast<unsigned long long>(n), static_cast<unsigned long long>(size_),
+             static_cast<unsigned long long>(capacity_));
+      }
+      if (n > 0) {
+        std::memcpy(data_ + size_, data, n);
+      }
+    }
+    size_ += n;
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be written as bytes");
+    write(&value, sizeof(T));
+  }
+
+  void write(const std::string& value) {
+    write(static_cast<std::uint64_t>(value.size()));
+    write(value.data(), value.size());
+  }
+
+  template <typename T>
+  void write(const std::vector<T>& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only vectors of trivially copyable values can be written as bytes");
+    write(static_cast<std::uint64_t>(value.size()));
+    write(value.data(), value.size() * sizeof(T));
+  }
+
+  // Bytes written (or counted) so far
+  std::size_t size() const noexcept { return size_; }
+  bool counting() const noexcept { return data_ == nullptr; }
+};
+
+class raw_reader {
+  const Rbyte* data_;
+  std::size_t size_;
+  std::size_t pos_ = 0;
+
+  void check(std::size_t n) const {
+    if (n > size_ - pos_) {
+      stop("Can't read %llu bytes at offset %llu of a raw vector of %llu bytes",
+           static_cast<unsigned long long>(n), static_cast<unsigned long long>(pos_),
+           static_cast<unsigned long long>(size_));
+    }
+  }
+
+ public:
+  explicit raw_reader(SEXP x)
+      : data_(RAW(x)), size_(static_cast<std::size_t>(Rf_xlength(x))) {}
+
+  void read(void* data, std::size_t n) {
+    check(n);
+    if (n > 0) {
+      std::memcpy(data, data_ + pos_, n);
+    }
+    pos_ += n;
+  }
+
+  template <typename T>
+  void read(T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be read as bytes");
+    read(&value, sizeof(T));
+  }
+
+  void read(std::string& value) {
+    const std::size_t n = read_size(1);
+    value.assign(reinterpret_cast<const char*>(data_ + pos_), n);
+    pos_ += n;
+  }
+
+  template <typename T>
+  void read(std::vector<T>& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only vectors of trivially copyable values can be read as bytes");
+    const std::size_t n = read_size(sizeof(T));
+    value.resize(n);
+    read(value.data(), n * sizeof(T));
+  }
+
+  template <typename T>
+  T read() {
+    T value;
+    read(value);
+    return value;
+  }
+
+  // A length prefix, checked against the bytes left for elements of `width` bytes
+  std::size_t read_size(std::size_t width) {
+    std::uint64_t n;
+    read(n);
+    if (n > (size_ - pos_) / width) {
+      stop("Can't read %llu elements of %llu bytes at offset %llu of a raw vector of "
+           "%llu bytes",
+           static_cast<unsigned long long>(n), static_cast<unsigned long long>(width),
+           static_cast<unsigned long long>(pos_), static_cast<unsigned long long>(size_));
+    }
+    return static_cast<std::size_t>(n);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t position() const noexcept { return pos_; }
+  std::size_t remaining() const noexcept { return size_ - pos_; }
+};
+
+// `x` encoded by `encode(x, writer)` into a raw vector of exactly the right size
+template <typename T, typename Encode>
+sexp encode_raws(const T& x, Encode&& encode) {
+  raw_writer counter;
+  encode(x, counter);
+  sexp out = safe[Rf_allocVector](RAWSXP, static_cast<R_xlen_t>(counter.size()));
+  raw_writer writer(out);
+  encode(x, writer);
+  if (writer.size() != counter.size()) {
+    stop("Encoding wrote %llu bytes, but counted %llu",
+         static_cast<unsigned long long>(writer.size()),
+         static_cast<unsigned long long>(counter.size()));
+  }
+  return out;
+}
+
+}  // namespace cpp4r
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>  // for min, max
+#include <climits>    // for INT_MAX
+#include <cstring>    // for memcpy
+#include <exception>  // for exception_ptr, current_exception, rethrow_exception
+#include <ios>        // for streamsize, streamoff, ios_base
+#include <streambuf>  // for streambuf
+#include <vector>     // for vector
+
+#include "Rversion.h"
+#include "cpp4r/R.hpp"        // for SEXP, RAW, RAW_OR_NULL, RAW_GET_REGION
+#include "cpp4r/protect.hpp"  // for safe, detail::store
+#include "cpp4r/raws.hpp"     // for raws
+
+// `std::streambuf`s over raw vectors, for binary I/O through `std::ostream` and
+// `std::istream` without going through `std::vector<uint8_t>` or `std::ostringstream`.
+//
+// `raw_ostreambuf` writes straight into the memory of a raw vector, which grows by
+// doubling like a `writable::raws`. `finish()` gives back the bytes written. From R
+// 4.6 the vector is allocated as resizable and is shrunk to size in place, so nothing
+// is copied. Before that, trimming it to size costs one copy, unless it was given
+// exactly the right capacity up front. `std::ostream` swallows exceptions from its
+// buffer, so when growing fails (e.g. R can't allocate) the write fails, the error is
+// kept and `finish()` throws it instead of returning the bytes.
+//
+// `raw_istreambuf` reads a raw vector in place. An ALTREP raw vector without a data
+// pointer is read in chunks with `RAW_GET_REGION()` instead, so it isn't materialized.
+// An R error while reading a chunk is thrown as an exception, which `std::istream`
+// turns into `badbit`; call `in.exceptions(std::ios_base::badbit)` to have it rethrown.
+//
+//   cpp4r::raw_ostreambuf buf;
+//   std::ostream out(&buf);
+//   out.write(data, n);
+//   cpp4r::raws bytes = buf.finish();
+
+namespace cpp4r {
+
+namespace detail {
+
+// Bytes read at a time from an ALTREP raw vector
+constexpr R_xlen_t raw_stream_chunk = 1 << 16;
+
+// Bytes of the first allocation when nothing was reserved
+constexpr R_xlen_t raw_stream_initial_capacity = 1 << 12;
+
+inline SEXP alloc_raw_buffer(R_xlen_t capacity) {
+#if R_VERSION >= R_Version(4, 6, 0)
+  return safe[R_allocResizableVector](RAWSXP, capacity);
+#else
+  return safe[Rf_allocVector](RAWSXP, capacity);
+#endif
+}
+
+}  // namespace detail
+
+class raw_ostreambuf : public std::streambuf {
+  SEXP data_ = R_NilValue;
+  SEXP protect_ = R_NilValue;
+  R_xlen_t capacity_ = 0;
+  std::exception_ptr error_;
+
+  char* begin() const noexcept { return reinterpret_cast<char*>(RAW(data_)); }
+
+  // Points the put area at the buffer, `size` bytes in. `pbump()` takes an `int`, so
+  // large offsets are applied in steps.
+  void set_put_area(R_xlen_t size) {
+    char* p = begin();
+    setp(p, p + capacity_);
+    while (size > 0) {
+      const int step = static_cast<int>(std::min<R_xlen_t>(size, INT_MAX));
+      pbump(step);
+      size -= step;
+    }
+  }
+
+  void replace(SEXP data, R_xlen_t capacity) {
+    SEXP old_protect = protect_;
+    data_ = data;
+    capacity_ = capacity;
+    protect_ = detail::store::insert(data_);
+    detail::store::release(old_protect);
+  }
+
+  // Whether there is room for `needed` bytes in all, keeping the error otherwise
+  bool grow(R_xlen_t needed) {
+    if (error_) {
+      return false;
+    }
+    try {
+      R_xlen_t capacity = std::max(capacity_ * 2, detail::raw_stream_initial_capacity);
+      reserve(std::max(capacity, needed));
+    } catch (...) {
+      error_ = std::current_exception();
+      return false;
+    }
+    return true;
+  }
+
+  void reset() noexcept {
+    detail::store::release(protect_);
+    data_ = R_NilValue;
+    protect_ = R_NilValue;
+    capacity_ = 0;
+    setp(nullptr, nullptr);
+  }
+
+ protected:
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    if (pptr() == epptr() && !grow(size() + 1)) {
+      return traits_type::eof();
+    }
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    if (n <= 0) {
+      return 0;
+    }
+    if (n > epptr() - pptr() && !grow(size() + static_cast<R_xlen_t>(n))) {
+      return 0;
+    }
+    std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+    R_xlen_t left = static_cast<R_xlen_t>(n);
+    while (left > 0) {
+      const int step = static_cast<int>(std::min<R_xlen_t>(left, INT_MAX));
+      pbump(step);
+      left -= step;
+    }
+    return n;
+  }
+
+  // Only reports the position, for `tellp()`
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    if (off != 0 || dir == std::ios_base::beg || !(which & std::ios_base::out)) {
+      return pos_type(off_type(-1));
+    }
+    return pos_type(static_cast<off_type>(size()));
+  }
+
+ public:
+  // A buffer with room for `capacity` bytes
+  explicit raw_ostreambuf(R_xlen_t capacity = 0) {
+    if (capacity > 0) {
+      reserve(capacity);
+    }
+  }
+
+  raw_ostreambuf(const raw_ostreambuf&) = delete;
+  raw_ostreambuf& operator=(const raw_ostreambuf&) = delete;
+
+  ~raw_ostreambuf() override { detail::store::release(protect_); }
+
+  // Bytes written so far
+  R_xlen_t size() const noexcept {
+    return data_ == R_NilValue ? 0 : static_cast<R_xlen_t>(pptr() - pbase());
+  }
+
+  R_xlen_t capacity() const noexcept { return capacity_; }
+
+  // Makes room for `capacity` bytes in all
+  void reserve(R_xlen_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    const R_xlen_t size = this->size();
+    SEXP data = detail::alloc_raw_buffer(capacity);
+    if (size > 0) {
+      std::memcpy(RAW(data), begin(), static_cast<std::size_t>(size));
+    }
+    replace(data, capacity);
+    set_put_area(size);
+  }
+
+  // The bytes written so far, or the error that made a write fail. The buffer is left
+  // empty.
+  raws finish() {
+    if (error_) {
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      reset();
+      std::rethrow_exception(error);
+    }
+    const R_xlen_t size = this->size();
+    SEXP out = data_;
+    if (out == R_NilValue) {
+      out = safe[Rf_allocVector](RAWSXP, 0);
+    } else if (size != capacity_) {
+#if R_VERSION >= R_Version(4, 6, 0)
+      R_resizeVector(out, size);
+#else
+      out = safe[Rf_allocVector](RAWSXP, size);
+      std::memcpy(RAW(out), begin(), static_cast<std::size_t>(size));
+#endif
+    }
+    raws result(out);
+    reset();
+    return result;
+  }
+};
+
+class raw_istreambuf : public std::streambuf {
+  raws data_;
+  const Rbyte* p_ = nullptr;
+  R_xlen_t size_ = 0;
+
+  // The next byte to read is `pos_` plus the offset into the get area. With a data
+  // pointer the get area is the whole vector and `pos_` stays 0; without one it holds
+  // the chunk starting at `pos_`.
+  R_xlen_t pos_ = 0;
+  std::vector<char> buf_;  // the chunk, without a data pointer
+
+  R_xlen_t position() const noexcept {
+    return pos_ + static_cast<R_xlen_t>(gptr() - eback());
+  }
+
+  // Loads the chunk starting at `pos` into the get area
+  void load(R_xlen_t pos) {
+    pos_ = pos;
+    const R_xlen_t n =
+        std::max<R_xlen_t>(std::min(detail::raw_stream_chunk, size_ - pos), 0);
+    if (n > 0) {
+      safe[RAW_GET_REGION](data_, pos, n, reinterpret_cast<Rbyte*>(buf_.data()));
+    }
+    setg(buf_.data(), buf_.data(), buf_.data() + n);
+  }
+
+  void move_to(R_xlen_t pos) {
+    if (p_ != nullptr) {
+      char* base = const_cast<char*>(reinterpret_cast<const char*>(p_));
+      setg(base, base, base + size_);
+      gbump_large(pos);
+    } else if (pos >= pos_ && pos < pos_ + (egptr() - eback())) {
+      setg(eback(), eback() + (pos - pos_), egptr());
+    } else {
+      load(pos);
+    }
+  }
+
+  void gbump_large(R_xlen_t n) {
+    while (n > 0) {
+      const int step = static_cast<int>(std::min<R_xlen_t>(n, INT_MAX));
+      gbump(step);
+      n -= step;
+    }
+  }
+
+ protected:
+  int_type underflow() override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+    if (p_ != nullptr || position() >= size_) {
+      return traits_type::eof();
+    }
+    load(position());
+    return traits_type::to_int_type(*gptr());
+  }
+
+  std::streamsize xsgetn(char* s, std::streamsize n) override {
+    const R_xlen_t pos = position();
+    const R_xlen_t count = std::min(static_cast<R_xlen_t>(n), size_ - pos);
+    if (count <= 0) {
+      return 0;
+    }
+    if (p_ != nullptr) {
+      std::memcpy(s, p_ + pos, static_cast<std::size_t>(count));
+    } else {
+      // Read straight into `s`, past the chunk
+      R_xlen_t done = std::min(count, static_cast<R_xlen_t>(egptr() - gptr()));
+      std::memcpy(s, gptr(), static_cast<std::size_t>(done));
+      if (count > done) {
+        safe[RAW_GET_REGION](data_, pos + done, count - done,
+                             reinterpret_cast<Rbyte*>(s + done));
+      }
+    }
+    move_to(pos + count);
+    return static_cast<std::streamsize>(count);
+  }
+
+  std::streamsize showmanyc() override {
+    const R_xlen_t left = size_ - position();
+    return left > 0 ? static_cast<std::streamsize>(left) : -1;
+  }
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in)) {
+      return pos_type(off_type(-1));
+    }
+    R_xlen_t base = dir == std::ios_base::beg   ? 0
+                    : dir == std::ios_base::cur ? position()
+                                                : size_;
+    const R_xlen_t pos = base + static_cast<R_xlen_t>(off);
+    if (pos < 0 || pos > size_) {
+      return pos_type(off_type(-1));
+    }
+    move_to(pos);
+    return pos_type(static_cast<off_type>(pos));
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+
+ public:
+  explicit raw_istreambuf(SEXP x) : data_(x), size_(Rf_xlength(x)) {
+    p_ = RAW_OR_NULL(data_);
+    if (p_ != nullptr) {
+      move_to(0);
+    } else {
+      buf_.resize(static_cast<std::size_t>(detail::raw_stream_chunk));
+      load(0);
+    }
+  }
+
+  raw_istreambuf(const raw_istreambuf&) = delete;
+  raw_istreambuf& operator=(const raw_istreambuf&) = delete;
+
+  R_xlen_t size() const noexcept { return size_; }
+};
+
+}  // namespace cpp4r
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <cmath>       // for fabs
+#include <cstdint>     // for uint8_t
+#include <functional>  // for greater
+#include <queue>       // for priority_queue
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+#include "cpp4r/R.hpp"            // for R_xlen_t, NA_REAL, ISNAN
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_LIKELY
+#include "cpp4r/doubles.hpp"      // for doubles
+#include "cpp4r/protect.hpp"      // for stop
+
+// Rolling-window statistics over doubles in O(n) (O(n log width) for the median).
+//
+// Every function returns a vector as long as `x`, whose element `i` summarises the window
+// of `width` elements that ends at `i` (`alignment::right`, the default), starts at `i`
+// (`alignment::left`) or is centred on it (`alignment::center`, with the extra element on
+// the right for even widths). Windows that stick out of `x` give `NA` unless `partial` is
+// set, in which case they use the elements that exist.
+//
+// A window that contains `NA` or `NaN` gives `NA`, unless `na_rm` is set, in which case
+// missing values are skipped. A window without any value sums to 0 and gives `NA` for the
+// other statistics.
+//
+// The accumulators are updated as elements enter and leave the window:
+//
+//  - sums use Neumaier's compensated summation, with infinities counted apart so that
+//    an `Inf` leaving the window doesn't leave a `NaN` behind;
+//  - variances use Welford's update and its inverse;
+//  - minima and maxima keep a monotonic deque of candidate positions;
+//  - medians keep the lower and upper halves of the window in two heaps, dropping
+//    elements that left the window when they reach the top.
+//
+// Each statistic is available for raw spans (`const double*`, length and output pointer)
+// and for `doubles`.
+
+namespace cpp4r {
+namespace rolling {
+
+enum class alignment { right, center, left };
+
+struct options {
+  alignment align = alignment::right;
+  // Skip `NA` and `NaN` instead of propagating them
+  bool na_rm = false;
+  // Summarise the incomplete windows at the edges instead of giving `NA`
+  bool partial = false;
+};
+
+}  // namespace rolling
+
+namespace detail {
+namespace rolling {
+
+// Neumaier's compensated sum over the finite values in the window
+class sum_accumulator {
+ public:
+  explicit sum_accumulator(const double*, R_xlen_t) {}
+
+  void add(double v, R_xlen_t) {
+    ++n_;
+    if (v == R_PosInf) {
+      ++pos_inf_;
+    } else if (v == R_NegInf) {
+      ++neg_inf_;
+    } else {
+      compensated_add(v);
+    }
+  }
+
+  void remove(double v, R_xlen_t) {
+    if (--n_ == 0) {
+      // Start afresh so that rounding never outlives the values that caused it
+      s_ = c_ = 0;
+      pos_inf_ = neg_inf_ = 0;
+      return;
+    }
+    if (v == R_PosInf) {
+      --pos_inf_;
+    } else if (v == R_NegInf) {
+      --neg_inf_;
+    } else {
+      compensated_add(-v);
+    }
+  }
+
+  double value() const {
+    if (pos_inf_ > 0) {
+      return neg_inf_ > 0 ? R_NaN : R_PosInf;
+    }
+    if (neg_inf_ > 0) {
+      return R_NegInf;
+    }
+    return s_ + c_;
+  }
+
+  R_xlen_t size() const { return n_; }
+
+ private:
+  double s_ = 0;
+  double c_ = 0;
+  R_xlen_t n_ = 0;
+  R_xlen_t pos_inf_ = 0;
+  R_xlen_t neg_inf_ = 0;
+
+  void compensated_add(double v) {
+    const double t = s_ + v;
+    if (std::fabs(s_) >= std::fabs(v)) {
+      c_ += (s_ - t) + v;
+    } else {
+      c_ += (v - t) + s_;
+    }
+    s_ = t;
+  }
+};
+
+class mean_accumulator : public sum_accumulator {
+ public:
+  using sum_accumulator::sum_accumulator;
+
+  double value() const {
+    return size() == 0 ? NA_REAL : sum_accumulator::value() / size();
+  }
+};
+
+// Welford's running mean and sum of squared deviations, updated both ways
+class var_accumulator {
+ public:
+  explicit var_accumulator(const double*, R_xlen_t) {}
+
+  void add(double v, R_xlen_t) {
+    ++n_;
+    if (!R_FINITE(v)) {
+      ++infinite_;
+      return;
+    }
+    ++finite_;
+    const double d = v - mean_;
+    mean_ += d / finite_;
+    m2_ += d * (v - mean_);
+  }
+
+  void remove(double v, R_xlen_t) {
+    --n_;
+    if (!R_FINITE(v)) {
+      --infinite_;
+      return;
+    }
+    if (--finite_ == 0) {
+      mean_ = m2_ = 0;
+      return;
+    }
+    const double d = v - mean_;
+    mean_ -= d / finite_;
+    m2_ -= d * (v - mean_);
+  }
+
+  double value() const {
+    if (n_ < 2) {
+      return NA_REAL;
+    }
+    if (infinite_ > 0) {
+      return R_NaN;
+    }
+    return m2_ > 0 ? m2_ / (n_ - 1) : 0;
+  }
+
+ private:
+  double mean_ = 0;
+  double m2_ = 0;
+  R_xlen_t n_ = 0;
+  R_xlen_t finite_ = 0;
+  R_xlen_t infinite_ = 0;
+};
+
+// Positions of the window whose value is smaller (larger) than every later one; the
+// front is the minimum (maximum). Every position enters and leaves the deque once.
+template <bool Max>
+class extreme_accumulator {
+ public:
+  extreme_accumulator(const double* x, R_xlen_t n) : x_(x), deque_(n) {}
+
+  void add(double v, R_xlen_t j) {
+    while (tail_ > head_ && dominated(x_[deque_[tail_ - 1]], v)) {
+      --tail_;
+    }
+    deque_[tail_++] = j;
+  }
+
+  void remove(double, R_xlen_t j) {
+    if (head_ < tail_ && deque_[head_] == j) {
+      ++head_;
+    }
+  }
+
+  double value() const { return head_ < tail_ ? x_[deque_[head_]] : NA_REAL; }
+
+ private:
+  const double* x_;
+  std::vector<R_xlen_t> deque_;
+  R_xlen_t head_ = 0;
+  R_xlen_t tail_ = 0;
+
+  static bool dominated(double old, double v) { return Max ? old <= v : old >= v; }
+};
+
+// Lower half of the window in a max-heap and upper half in a min-heap, ordered by
+// (value, position). Elements that left the window stay in their heap until they reach
+// the top; `side_` remembers which half every live element is in.
+class median_accumulator {
+ public:
+  median_accumulator(const double*, R_xlen_t n) : side_(n) {}
+
+  void add(double v, R_xlen_t j) {
+    const entry e(v, j);
+    if (low_size_ == 0 || e < low_.top()) {
+      low_.push(e);
+      side_[j] = 0;
+      ++low_size_;
+    } else {
+      high_.push(e);
+      side_[j] = 1;
+      ++high_size_;
+    }
+    rebalance();
+  }
+
+  void remove(double, R_xlen_t j) {
+    // Elements leave in order of position, so everything before `j + 1` is gone
+    start_ = j + 1;
+    if (side_[j] == 0) {
+      --low_size_;
+    } else {
+      --high_size_;
+    }
+    prune();
+    rebalance();
+  }
+
+  double value() const {
+    if (low_size_ == 0) {
+      return NA_REAL;
+    }
+    if (low_size_ > high_size_) {
+      return low_.top().first;
+    }
+    return (low_.top().first + high_.top().first) / 2;
+  }
+
+ private:
+  using entry = std::pair<double, R_xlen_t>;
+
+  std::priority_queue<entry> low_;
+  std::priority_queue<entry, std::vector<entry>, std::greater<entry>> high_;
+  std::vector<uint8_t> side_;
+  R_xlen_t low_size_ = 0;
+  R_xlen_t high_size_ = 0;
+  R_xlen_t start_ = 0;
+
+  void prune() {
+    while (!low_.empty() && low_.top().second < start_) {
+      low_.pop();
+    }
+    while (!high_.empty() && high_.top().second < start_) {
+      high_.pop();
+    }
+  }
+
+  // Keep `low_size_ == high_size_` or `low_size_ == high_size_ + 1`
+  void rebalance() {
+    while (low_size_ > high_size_ + 1) {
+      const entry e = low_.top();
+      low_.pop();
+      high_.push(e);
+      side_[e.second] = 1;
+      --low_size_;
+      ++high_size_;
+      prune();
+    }
+    while (high_size_ > low_size_) {
+      const entry e = high_.top();
+      high_.pop();
+      low_.push(e);
+      side_[e.second] = 0;
+      --high_size_;
+      ++low_size_;
+      prune();
+    }
+  }
+};
+
+// Slides the window over `x`, feeding the non-missing values to a fresh `Acc`
+template <typename Acc>
+void slide(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+           const cpp4r::rolling::options& options) {
+  if (width < 1) {
+    stop("`width` must be a positive integer");
+  }
+
+  R_xlen_t before;
+  switch (options.align) {
+    case cpp4r::rolling::alignment::right:
+      before = width - 1;
+      break;
+    case cpp4r::rolling::alignment::left:
+      before = 0;
+      break;
+    default:
+      before = (width - 1) / 2;
+      break;
+  }
+  const R_xlen_t after = width - 1 - before;
+
+  Acc acc(x, n);
+  R_xlen_t missing = 0;
+  R_xlen_t lo = 0;
+  R_xlen_t hi = 0;
+
+  for (R_xlen_t i = 0; i < n; ++i) {
+    const R_xlen_t want_hi = i + after + 1 < n ? i + after + 1 : n;
+    const R_xlen_t want_lo = i > before ? i - before : 0;
+    for (; hi < want_hi; ++hi) {
+      const double v = x[hi];
+      if (ISNAN(v)) {
+        ++missing;
+      } else {
+        acc.add(v, hi);
+      }
+    }
+    for (; lo < want_lo; ++lo) {
+      const double v = x[lo];
+      if (ISNAN(v)) {
+        --missing;
+      } else {
+        acc.remove(v, lo);
+      }
+    }
+
+    const bool complete = i >= before && i + after < n;
+    if (CPP4R_LIKELY(complete || options.partial) && (missing == 0 || options.na_rm)) {
+      out[i] = acc.value();
+    } else {
+      out[i] = NA_REAL;
+    }
+  }
+}
+
+template <typename Acc>
+writable::doubles slide(const doubles& x, R_xlen_t width,
+                        const cpp4r::rolling::options& options) {
+  const R_xlen_t n = x.size();
+  writable::doubles out(n);
+  slide<Acc>(REAL(x.data()), n, width, REAL(out.data()), options);
+  return out;
+}
+
+}  // namespace rolling
+}  // namespace detail
+
+namespace rolling {
+
+inline void sum(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+                const options& opts = options()) {
+  detail::rolling::slide<detail::rolling::sum_accumulator>(x, n, width, out, opts);
+}
+
+inline writable::doubles sum(const doubles& x, R_xlen_t width,
+                             const options& opts = options()) {
+  return detail::rolling::slide<detail::rolling::sum_accumulator>(x, width, opts);
+}
+
+inline void mean(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+                 const options& opts = options()) {
+  detail::rolling::slide<detail::rolling::mean_accumulator>(x, n, width, out, opts);
+}
+
+inline writable::doubles mean(const doubles& x, R_xlen_t width,
+                              const options& opts = options()) {
+  return detail::rolling::slide<detail::rolling::mean_accumulator>(x, width, opts);
+}
+
+// Sample variance (denominator `n - 1`), like `var()`
+inline void var(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+                const options& opts = options()) {
+  detail::rolling::slide<detail::rolling::var_accumulator>(x, n, width, out, opts);
+}
+
+inline writable::doubles var(const doubles& x, R_xlen_t width,
+                             const options& opts = options()) {
+  return detail::rolling::slide<detail::rolling::var_accumulator>(x, width, opts);
+}
+
+inline void min(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+                const options& opts = options()) {
+  detail::rolling::slide<detail::rolling::extreme_accumulator<false>>(x, n, width, out,
+                                                                      opts);
+}
+
+inline writable::doubles min(const doubles& x, R_xlen_t width,
+                             const options& opts = options()) {
+  return detail::rolling::slide<detail::rolling::extreme_accumulator<false>>(x, width,
+                                                                             opts);
+}
+
+inline void max(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+                const options& opts = options()) {
+  detail::rolling::slide<detail::rolling::extreme_accumulator<true>>(x, n, width, out,
+                                                                     opts);
+}
+
+inline writable::doubles max(const doubles& x, R_xlen_t width,
+                             const options& opts = options()) {
+  return detail::rolling::slide<detail::rolling::extreme_accumulator<true>>(x, width,
+                                                                            opts);
+}
+
+inline void median(const double* x, R_xlen_t n, R_xlen_t width, double* out,
+                   const options& opts = options()) {
+  detail::rolling::slide<detail::rolling::median_accumulator>(x, n, width, out, opts);
+}
+
+inline writable::doubles median(const doubles& x, R_xlen_t width,
+                                const options& opts = options()) {
+  return detail::rolling::slide<detail::rolling::median_accumulator>(x, width, opts);
+}
+
+}  // namespace rolling
+}  // namespace cpp4r
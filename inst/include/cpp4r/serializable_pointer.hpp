@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>      // for nullptr_t
+#include <memory>       // for bad_weak_ptr, unique_ptr
+#include <string>       // for string
+#include <type_traits>  // for add_lvalue_reference
+
+#include "cpp4r/R.hpp"                 // for SEXP, R_NilValue
+#include "cpp4r/external_pointer.hpp"  // for external_pointer
+#include "cpp4r/protect.hpp"           // for safe, stop, detail::r_callback
+#include "cpp4r/raw_io.hpp"            // for raw_writer, raw_reader, encode_raws
+#include "cpp4r/sexp.hpp"              // for sexp
+
+// After cpp4r/R.hpp, which sets up the R headers
+#include <R_ext/Altrep.h>  // for R_altrep_class_t, R_new_altrep, R_make_altraw_class
+
+// An external pointer that survives `serialize()`.
+//
+// A plain `external_pointer<T>` comes back from `saveRDS()` / `readRDS()`, or from a
+// `parallel` or `callr` worker, as a NULL pointer. A `serializable_pointer<T>` is an
+// ALTREP raw vector of length 0 that owns a `T` through an `external_pointer<T>`. When
+// R serializes it, the object is encoded with
+//
+//   void serialize(const T& x, cpp4r::raw_writer& out);
+//
+// found by argument-dependent lookup, straight into the raw vector that R writes out.
+// When R unserializes it, only those bytes are kept; the object is rebuilt with
+//
+//   void deserialize(T& x, cpp4r::raw_reader& in);
+//
+// into a default constructed `T` the first time `get()` is called, so handles that are
+// never used cost nothing. Serializing a handle that was never used writes its bytes
+// back out unchanged.
+//
+// The ALTREP class must be registered while the package is loaded, e.g.
+//
+//   [[cpp4r::init]] void init_model(DllInfo* dll) {
+//     cpp4r::serializable_pointer<model>::init(dll, "mypackage", "model");
+//   }
+//
+// R finds the class again by these names when unserializing, loading the package if
+// needed.
+//
+// Copies, including R's duplicates, share the same object, also when they are made
+// from an unserialized handle before the object is rebuilt.
+
+namespace cpp4r {
+
+template <typename T>
+class serializable_pointer {
+  sexp data_ = R_NilValue;
+
+  static R_altrep_class_t& altrep_class() {
+    static R_altrep_class_t cls;
+    return cls;
+  }
+
+  static bool& registered() {
+    static bool registered = false;
+    return registered;
+  }
+
+  static void encode(const T& x, raw_writer& out) { serialize(x, out); }
+
+  // The cell of a handle holds the external pointer to the object once it is built, and
+  // its serialized bytes until then. Duplicates share the cell, and so the object.
+  enum cell_slot { object_slot = 0, bytes_slot = 1 };
+
+  static SEXP make_cell(SEXP object, SEXP bytes) {
+    SEXP cell = PROTECT(Rf_allocVector(VECSXP, 2));
+    SET_VECTOR_ELT(cell, object_slot, object);
+    SET_VECTOR_ELT(cell, bytes_slot, bytes);
+    UNPROTECT(1);
+    return cell;
+  }
+
+  // The object behind `x`, if it has been built
+  static T* address(SEXP x) {
+    SEXP ptr = VECTOR_ELT(R_altrep_data1(x), object_slot);
+    if (detail::r_typeof(ptr) != EXTPTRSXP) {
+      return nullptr;
+    }
+    return static_cast<T*>(R_ExternalPtrAddr(ptr));
+  }
+
+  // The object behind `x`, rebuilt from its serialized bytes if needed
+  static T* object(SEXP x) {
+    T* addr = address(x);
+    if (addr != nullptr) {
+      return addr;
+    }
+    SEXP cell = R_altrep_data1(x);
+    SEXP bytes = VECTOR_ELT(cell, bytes_slot);
+    if (bytes == R_NilValue) {
+      return nullptr;
+    }
+    std::unique_ptr<T> out(new T());
+    raw_reader in(bytes);
+    deserialize(*out, in);
+    external_pointer<T> owner(out.release());
+    SET_VECTOR_ELT(cell, object_slot, owner);
+    SET_VECTOR_ELT(cell, bytes_slot, R_NilValue);
+    return owner.get();
+  }
+
+  static R_xlen_t length(SEXP) { return 0; }
+
+  static void* dataptr(SEXP, Rboolean) {
+    static Rbyte empty = 0;
+    return &empty;
+  }
+
+  static const void* dataptr_or_null(SEXP x) { return dataptr(x, FALSE); }
+
+  static SEXP serialized_state(SEXP x) {
+    return detail::r_callback([&]() -> SEXP {
+      T* addr = address(x);
+      if (addr == nullptr) {
+        return VECTOR_ELT(R_altrep_data1(x), bytes_slot);
+      }
+      sexp out = encode_raws(*addr, encode);
+      return out;
+    });
+  }
+
+  static SEXP unserialize(SEXP, SEXP state) {
+    SEXP cell = PROTECT(make_cell(R_NilValue, state));
+    SEXP out = R_new_altrep(altrep_class(), cell, R_NilValue);
+    UNPROTECT(1);
+    return out;
+  }
+
+  static SEXP duplicate(SEXP x, Rboolean) {
+    return R_new_altrep(altrep_class(), R_altrep_data1(x), R_NilValue);
+  }
+
+  static SEXP valid_type(SEXP data) {
+    if (data == R_NilValue) {
+      return data;
+    }
+    if (!registered() || !R_altrep_inherits(data, altrep_class())) {
+      stop("Expected a serializable pointer of class '%s'", class_name().c_str());
+    }
+    return data;
+  }
+
+  static std::string& class_name() {
+    static std::string name;
+    return name;
+  }
+
+ public:
+  using pointer = T*;
+
+  // Registers the ALTREP class for `T` as `name` in `package`. The name must be unique
+  // within the package.
+  static void init(DllInfo* dll, const char* package, const char* name) {
+    class_name() = name;
+    R_altrep_class_t& cls = altrep_class();
+    cls = R_make_altraw_class(name, package, dll);
+    R_set_altrep_Length_method(cls, length);
+    R_set_altvec_Dataptr_method(cls, dataptr);
+    R_set_altvec_Dataptr_or_null_method(cls, dataptr_or_null);
+    R_set_altrep_Serialized_state_method(cls, serialized_state);
+    R_set_altrep_Unserialize_method(cls, unserialize);
+    R_set_altrep_Duplicate_method(cls, duplicate);
+    registered() = true;
+  }
+
+  serializable_pointer() noexcept {}
+  serializable_pointer(std::nullptr_t) noexcept {}
+
+  serializable_pointer(SEXP data) : data_(valid_type(data)) {}
+
+  // Takes ownership of `p`
+  explicit serializable_pointer(pointer p) {
+    if (!registered()) {
+      stop("`serializable_pointer<T>::init()` must be called before making a handle");
+    }
+    external_pointer<T> owner(p);
+    sexp cell = safe[make_cell](owner, R_NilValue);
+    data_ = safe[R_new_altrep](altrep_class(), cell, R_NilValue);
+  }
+
+  operator SEXP() const noexcept { return data_; }
+
+  // The object, rebuilt from its serialized bytes on first use after unserializing
+  pointer get() const {
+    if (data_ == R_NilValue) {
+      return nullptr;
+    }
+    return object(data_);
+  }
+
+  typename std::add_lvalue_reference<T>::type operator*() const {
+    pointer addr = get();
+    if (addr == nullptr) {
+      throw std::bad_weak_ptr();
+    }
+    return *addr;
+  }
+
+  pointer operator->() const {
+    pointer addr = get();
+    if (addr == nullptr) {
+      throw std::bad_weak_ptr();
+    }
+    return addr;
+  }
+
+  // Whether the object exists, without rebuilding it
+  bool materialized() const noexcept {
+    return data_ != R_NilValue && address(data_) != nullptr;
+  }
+
+  operator bool() const noexcept { return data_ != R_NilValue; }
+};
+
+}  // namespace cpp4r
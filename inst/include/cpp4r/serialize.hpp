@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>    // for min
+#include <cstddef>      // for size_t
+#include <cstdio>       // for FILE, fopen, fwrite, fread, fclose, setvbuf
+#include <cstring>      // for memcpy
+#include <functional>   // for function
+#include <string>       // for string
+#include <type_traits>  // for enable_if, is_convertible
+#include <utility>      // for move
+#include <vector>       // for vector
+
+#include "cpp4r/R.hpp"              // for SEXP, R_Serialize, R_Unserialize
+#include "cpp4r/protect.hpp"        // for unwind_protect, stop, detail::r_callback
+#include "cpp4r/raw_streambuf.hpp"  // for raw_ostreambuf, raw_istreambuf
+#include "cpp4r/raws.hpp"           // for raws
+#include "cpp4r/sexp.hpp"           // for sexp
+
+// `serialize()` and `unserialize()` straight from C++, into and out of any byte sink
+// or source rather than an R connection.
+//
+// A sink is any object with `void write(const char* data, std::size_t n)`; a source is
+// any object with `std::size_t read(char* data, std::size_t n)`, which reads up to `n`
+// bytes and returns how many it read, fewer only at the end of the data. cpp4r comes
+// with sinks and sources for
+//
+// - memory: `raw_sink` writes into a raw vector, `raw_source` reads one;
+// - files: `file_sink` and `file_source` go through a large buffer, and pass large
+//   writes and reads straight to the file;
+// - callbacks: `callback_sink` and `callback_source` hand buffered chunks to a
+//   `std::function`, e.g. to write to a socket or a compressor.
+//
+//   cpp4r::file_sink out("model.bin");
+//   cpp4r::serialize(x, out);
+//   out.close();
+//
+// The data is written in version 3 of R's serialization format, which `base::
+// unserialize()` reads back. `serialize_format::xdr`, the default, is big-endian and
+// portable, like `base::serialize()`. `serialize_format::native` is R's native binary
+// format: numbers are written in the byte order of the machine, which means R can pass
+// the payload of each vector to the sink straight from its memory in large contiguous
+// blocks, without encoding it element by element. Use it when the data is read back on
+// the same kind of machine. `unserialize()` reads both.
+//
+// External pointers are serialized as NULL pointers, as usual.
+
+namespace cpp4r {
+
+enum class serialize_format { xdr, native };
+
+namespace detail {
+
+inline R_pstream_format_t r_pstream_format(serialize_format format) {
+  return format == serialize_format::native ? R_pstream_binary_format
+                                            : R_pstream_xdr_format;
+}
+
+// Size of the buffer of file and callback sinks and sources
+constexpr std::size_t serialize_buffer_size = 1 << 20;
+
+template <typename Sink>
+void serialize_out_char(R_outpstream_t stream, int c) {
+  detail::r_callback([&]() -> SEXP {
+    const char ch = static_cast<char>(c);
+    static_cast<Sink*>(stream->data)->write(&ch, 1);
+    return R_NilValue;
+  });
+}
+
+template <typename Sink>
+void serialize_out_bytes(R_outpstream_t stream, void* buf, int length) {
+  detail::r_callback([&]() -> SEXP {
+    static_cast<Sink*>(stream->data)
+        ->write(static_cast<const char*>(buf), static_cast<std::size_t>(length));
+    return R_NilValue;
+  });
+}
+
+template <typename Source>
+void read_exactly(Source& source, char* data, std::size_t n) {
+  if (source.read(data, n) != n) {
+    stop("Unexpected end of serialized data");
+  }
+}
+
+template <typename Source>
+int serialize_in_char(R_inpstream_t stream) {
+  char ch = 0;
+  detail::r_callback([&]() -> SEXP {
+    read_exactly(*static_cast<Source*>(stream->data), &ch, 1);
+    return R_NilValue;
+  });
+  return static_cast<unsigned char>(ch);
+}
+
+template <typename Source>
+void serialize_in_bytes(R_inpstream_t stream, void* buf, int length) {
+  detail::r_callback([&]() -> SEXP {
+    read_exactly(*static_cast<Source*>(stream->data), static_cast<char*>(buf),
+                 static_cast<std::size_t>(length));
+    return R_NilValue;
+  });
+}
+
+// Collects small writes into chunks of `capacity` bytes for `put(data, n)`. Writes of
+// at least a chunk are passed on as they are.
+class sink_buffer {
+  std::vector<char> buf_;
+  std::size_t size_ = 0;
+
+ public:
+  explicit sink_buffer(std::size_t capacity) : buf_(capacity > 0 ? capacity : 1) {}
+
+  template <typename Put>
+  void write(const char* data, std::size_t n, Put&& put) {
+    if (n > buf_.size() - size_) {
+      flush(put);
+    }
+    if (n >= buf_.size()) {
+      put(data, n);
+      return;
+    }
+    std::memcpy(buf_.data() + size_, data, n);
+    size_ += n;
+  }
+
+  template <typename Put>
+  void flush(Put&& put) {
+    if (size_ > 0) {
+      const std::size_t n = size_;
+      size_ = 0;
+      put(buf_.data(), n);
+    }
+  }
+};
+
+// Reads ahead in chunks of `capacity` bytes from `get(data, n)`. Reads of at least a
+// chunk go straight to `get()`.
+class source_buffer {
+  std::vector<char> buf_;
+  std::size_t pos_ = 0;
+  std::size_t size_ = 0;
+
+ public:
+  explicit source_buffer(std::size_t capacity) : buf_(capacity > 0 ? capacity : 1) {}
+
+  template <typename Get>
+  std::size_t read(char* data, std::size_t n, Get&& get) {
+    std::size_t done = 0;
+    while (done < n) {
+      if (pos_ == size_) {
+        if (n - done >= buf_.size()) {
+          const std::size_t got = get(data + done, n - done);
+          done += got;
+          if (got == 0) {
+            break;
+          }
+          continue;
+        }
+        pos_ = 0;
+        size_ = get(buf_.data(), buf_.size());
+        if (size_ == 0) {
+          break;
+        }
+      }
+      const std::size_t step = std::min(n - done, size_ - pos_);
+      std::memcpy(data + done, buf_.data() + pos_, step);
+      pos_ += step;
+      done += step;
+    }
+    return done;
+  }
+};
+
+}  // namespace detail
+
+// Writes into a raw vector, see `raw_ostreambuf`
+class raw_sink {
+  raw_ostreambuf buf_;
+
+ public:
+  explicit raw_sink(R_xlen_t capacity = 0) : buf_(capacity) {}
+
+  void write(const char* data, std::size_t n) {
+    buf_.sputn(data, static_cast<std::streamsize>(n));
+  }
+
+  R_xlen_t size() const noexcept { return buf_.size(); }
+
+  // The bytes written so far. The sink is left empty.
+  raws finish() { return buf_.finish(); }
+};
+
+// Reads a raw vector in place, see `raw_istreambuf`
+class raw_source {
+  raw_istreambuf buf_;
+
+ public:
+  explicit raw_source(SEXP x) : buf_(x) {}
+
+  std::size_t read(char* data, std::size_t n) {
+    return static_cast<std::size_t>(buf_.sgetn(data, static_cast<std::streamsize>(n)));
+  }
+};
+
+class file_sink {
+  std::string path_;
+  std::FILE* file_;
+  detail::sink_buffer buf_;
+
+  void put(const char* data, std::size_t n) {
+    if (std::fwrite(data, 1, n, file_) != n) {
+      stop("Failed to write to '%s'", path_.c_str());
+    }
+  }
+
+ public:
+  explicit file_sink(const std::string& path,
+                     std::size_t buffer_size = detail::serialize_buffer_size)
+      : path_(path), file_(std::fopen(path.c_str(), "wb")), buf_(buffer_size) {
+    if (file_ == nullptr) {
+      stop("Can't open '%s' for writing", path_.c_str());
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+  }
+
+  file_sink(const file_sink&) = delete;
+  file_sink& operator=(const file_sink&) = delete;
+
+  // Closes the file without checking for errors, if `close()` wasn't called
+  ~file_sink() {
+    if (file_ != nullptr) {
+      std::fclose(file_);
+    }
+  }
+
+  void write(const char* data, std::size_t n) {
+    buf_.write(data, n, [this](const char* p, std::size_t m) { put(p, m); });
+  }
+
+  // Writes out what is buffered and closes the file
+  void close() {
+    if (file_ == nullptr) {
+      return;
+    }
+    buf_.flush([this](const char* p, std::size_t m) { put(p, m); });
+    std::FILE* file = file_;
+    file_ = nullptr;
+    if (std::fclose(file) != 0) {
+      stop("Failed to close '%s'", path_.c_str());
+    }
+  }
+};
+
+class file_source {
+  std::string path_;
+  std::FILE* file_;
+  detail::source_buffer buf_;
+
+ public:
+  explicit file_source(const std::string& path,
+                       std::size_t buffer_size = detail::serialize_buffer_size)
+      : path_(path), file_(std::fopen(path.c_str(), "rb")), buf_(buffer_size) {
+    if (file_ == nullptr) {
+      stop("Can't open '%s' for reading", path_.c_str());
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+  }
+
+  file_source(const file_source&) = delete;
+  file_source& operator=(const file_source&) = delete;
+
+  ~file_source() { std::fclose(file_); }
+
+  std::size_t read(char* data, std::size_t n) {
+    return buf_.read(data, n, [this](char* p, std::size_t m) {
+      const std::size_t got = std::fread(p, 1, m, file_);
+      if (got < m && std::ferror(file_)) {
+        stop("Failed to read from '%s'", path_.c_str());
+      }
+      return got;
+    });
+  }
+};
+
+// Passes the bytes to `write(data, n)` in chunks of `buffer_size`. Call `flush()` when
+// done.
+class callback_sink {
+  std::function<void(const char*, std::size_t)> write_;
+  detail::sink_buffer buf_;
+
+ public:
+  explicit callback_sink(std::function<void(const char*, std::size_t)> write,
+                         std::size_t buffer_size = detail::serialize_buffer_size)
+      : write_(std::move(write)), buf_(buffer_size) {}
+
+  void write(const char* data, std::size_t n) { buf_.write(data, n, write_); }
+
+  void flush() { buf_.flush(write_); }
+};
+
+// Gets the bytes from `read(data, n)`, which reads up to `n` bytes and returns how many
+// it read, 0 at the end of the data
+class callback_source {
+  std::function<std::size_t(char*, std::size_t)> read_;
+  detail::source_buffer buf_;
+
+ public:
+  explicit callback_source(std::function<std::size_t(char*, std::size_t)> read,
+                           std::size_t buffer_size = detail::serialize_buffer_size)
+      : read_(std::move(read)), buf_(buffer_size) {}
+
+  std::size_t read(char* data, std::size_t n) { return buf_.read(data, n, read_); }
+};
+
+// Serializes `x` into `sink`
+template <typename Sink>
+void serialize(SEXP x, Sink& sink, serialize_format format = serialize_format::xdr) {
+  struct R_outpstream_st stream;
+  unwind_protect([&] {
+    R_InitOutPStream(&stream, &sink, detail::r_pstream_format(format), 3,
+                     detail::serialize_out_char<Sink>, detail::serialize_out_bytes<Sink>,
+                     NULL, R_NilValue);
+    R_Serialize(x, &stream);
+  });
+}
+
+// `x` serialized into a raw vector
+inline raws serialize(SEXP x, serialize_format format = serialize_format::xdr) {
+  raw_sink sink;
+  serialize(x, sink, format);
+  return sink.finish();
+}
+
+// Unserializes an object from `source`
+template <typename Source, typename = typename std::enable_if<
+                              !std::is_convertible<Source, SEXP>::value>::type>
+sexp unserialize(Source& source) {
+  struct R_inpstream_st stream;
+  return unwind_protect([&] {
+    R_InitInPStream(&stream, &source, R_pstream_any_format,
+                    detail::serialize_in_char<Source>, detail::serialize_in_bytes<Source>,
+                    NULL, R_NilValue);
+    return R_Unserialize(&stream);
+  });
+}
+
+// Unserializes an object from the raw vector `x`
+inline sexp unserialize(SEXP x) {
+  raw_source source(x);
+  return unserialize(source);
+}
+
+}  // namespace cpp4r
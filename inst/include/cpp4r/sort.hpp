@@ -0,0 +1,515 @@
+#pragma once
+
+#include <algorithm>  // for stable_sort, fill, copy
+#include <climits>    // for INT_MAX
+#include <cstdint>    // for uint32_t, uint64_t, UINT32_MAX, UINT64_MAX
+#include <cstring>    // for memcpy, strcmp, strcoll
+#include <utility>    // for swap
+#include <vector>     // for vector
+
+#include "cpp4r/R.hpp"            // for SEXP, R_xlen_t, NA_INTEGER, ISNAN
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_LIKELY, CPP4R_UNLIKELY
+#include "cpp4r/doubles.hpp"      // for doubles
+#include "cpp4r/integers.hpp"     // for integers
+#include "cpp4r/logicals.hpp"     // for logicals
+#include "cpp4r/protect.hpp"      // for unwind_protect, stop
+#include "cpp4r/strings.hpp"      // for strings
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Stable radix sorting for atomic vectors, following `base::order(method = "radix")`:
+//
+//  - integers, logicals and doubles are mapped onto unsigned keys whose natural order is
+//    R's order and sorted with a least-significant-digit radix sort (8 bits per pass,
+//    passes where every key shares the digit are skipped);
+//  - strings are sorted with a most-significant-digit radix sort over the bytes of their
+//    UTF-8 representation (the "C" locale), or with `strcoll()` when `c_locale = false`.
+//    Only the CHARSXP pointers are permuted, the strings themselves are never copied;
+//  - `NA` and `NaN` tie with each other and go last unless `na_last = false`;
+//  - ties keep their original order, also when `decreasing = true`.
+//
+// Inputs longer than `detail::radix::parallel_threshold` run their histogram and scatter
+// passes on all OpenMP threads when the package is compiled with OpenMP. The R API is
+// only used before and after the parallel sections.
+
+namespace cpp4r {
+
+namespace detail {
+namespace radix {
+
+constexpr R_xlen_t parallel_threshold = 1 << 20;
+
+// Below this length a stable comparison sort beats the fixed cost of the radix passes
+constexpr R_xlen_t small_threshold = 64;
+
+inline int threads_for(R_xlen_t n) {
+#ifdef _OPENMP
+  if (n >= parallel_threshold) {
+    return omp_get_max_threads();
+  }
+#endif
+  (void)n;
+  return 1;
+}
+
+// [0, 2^32 - 2] for values, 2^32 - 1 for NA (or shifted up by one with NA at 0)
+inline uint32_t int_key(int x, bool decreasing, bool na_last) {
+  if (x == NA_INTEGER) {
+    return na_last ? UINT32_MAX : 0;
+  }
+  uint32_t k = (static_cast<uint32_t>(x) ^ 0x80000000u) - 1u;
+  if (decreasing) {
+    k = 0xFFFFFFFEu - k;
+  }
+  return na_last ? k : k + 1u;
+}
+
+inline int int_from_key(uint32_t k, bool decreasing, bool na_last) {
+  if (na_last) {
+    if (k == UINT32_MAX) return NA_INTEGER;
+  } else {
+    if (k == 0) return NA_INTEGER;
+    k -= 1u;
+  }
+  if (decreasing) {
+    k = 0xFFFFFFFEu - k;
+  }
+  return static_cast<int>((k + 1u) ^ 0x80000000u);
+}
+
+// Non-NaN doubles map onto [0x000FFFFFFFFFFFFF, 0xFFF0000000000000], which leaves the keys
+// at either end free for the missing values. As in R, -0.0 ties with 0.0 and NA ties with
+// NaN.
+inline uint64_t double_key(double x, bool decreasing, bool na_last) {
+  if (CPP4R_UNLIKELY(ISNAN(x))) {
+    return na_last ? UINT64_MAX : 0;
+  }
+  if (x == 0) {
+    x = 0;
+  }
+  uint64_t u;
+  std::memcpy(&u, &x, sizeof(u));
+  u = (u & 0x8000000000000000u) ? ~u : (u ^ 0x8000000000000000u);
+  if (decreasing) {
+    u = ~u;
+  }
+  return na_last ? u : u + 1u;
+}
+
+// Inverse of `double_key()` for keys of non-missing values
+inline double double_from_key(uint64_t u, bool decreasing, bool na_last) {
+  if (!na_last) {
+    u -= 1u;
+  }
+  if (decreasing) {
+    u = ~u;
+  }
+  u = (u & 0x8000000000000000u) ? (u ^ 0x8000000000000000u) : ~u;
+  double x;
+  std::memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+// Stable LSD radix sort of `keys`, carrying the 0-based positions in `idx` along when it
+// is not null. Both arrays hold the sorted result on return.
+template <typename Key>
+void lsd_sort(Key* keys, int* idx, R_xlen_t n) {
+  if (n < 2) {
+    return;
+  }
+
+  if (n < small_threshold) {
+    std::vector<int> perm(n);
+    for (R_xlen_t i = 0; i < n; ++i) perm[i] = static_cast<int>(i);
+    std::stable_sort(perm.begin(), perm.end(),
+                     [&](int a, int b) { return keys[a] < keys[b]; });
+    std::vector<Key> k(keys, keys + n);
+    std::vector<int> p;
+    if (idx != nullptr) p.assign(idx, idx + n);
+    for (R_xlen_t i = 0; i < n; ++i) {
+      keys[i] = k[perm[i]];
+      if (idx != nullptr) idx[i] = p[perm[i]];
+    }
+    return;
+  }
+
+  constexpr int passes = sizeof(Key);
+  std::vector<Key> keys_tmp(n);
+  std::vector<int> idx_tmp(idx != nullptr ? n : 0);
+
+  Key* src = keys;
+  Key* dst = keys_tmp.data();
+  int* isrc = idx;
+  int* idst = idx != nullptr ? idx_tmp.data() : nullptr;
+
+  int nthreads = threads_for(n);
+
+  if (nthreads == 1) {
+    // One sweep fills the histograms of every pass
+    std::vector<R_xlen_t> hist(static_cast<size_t>(passes) * 256, 0);
+    for (R_xlen_t i = 0; i < n; ++i) {
+      Key k = src[i];
+      for (int p = 0; p < passes; ++p) {
+        ++hist[p * 256 + ((k >> (p * 8)) & 0xFF)];
+      }
+    }
+
+    for (int p = 0; p < passes; ++p) {
+      const int shift = p * 8;
+      R_xlen_t* h = hist.data() + p * 256;
+      if (h[(src[0] >> shift) & 0xFF] == n) {
+        continue;
+      }
+
+      R_xlen_t running = 0;
+      for (int b = 0; b < 256; ++b) {
+        R_xlen_t c = h[b];
+        h[b] = running;
+        running += c;
+      }
+
+      if (isrc != nullptr) {
+        for (R_xlen_t i = 0; i < n; ++i) {
+          R_xlen_t to = h[(src[i] >> shift) & 0xFF]++;
+          dst[to] = src[i];
+          idst[to] = isrc[i];
+        }
+      } else {
+        for (R_xlen_t i = 0; i < n; ++i) {
+          dst[h[(src[i] >> shift) & 0xFF]++] = src[i];
+        }
+      }
+
+      std::swap(src, dst);
+      std::swap(isrc, idst);
+    }
+  }
+#ifdef _OPENMP
+  else {
+    // Each thread owns a contiguous chunk; per-thread offsets are laid out digit-major,
+    // thread-minor, which keeps the scatter stable.
+    std::vector<R_xlen_t> counts(static_cast<size_t>(nthreads) * 256);
+
+    for (int p = 0; p < passes; ++p) {
+      const int shift = p * 8;
+      bool skip = false;
+
+#pragma omp parallel num_threads(nthreads)
+      {
+        const int t = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        const R_xlen_t lo = n * t / nt;
+        const R_xlen_t hi = n * (t + 1) / nt;
+        R_xlen_t* c = counts.data() + t * 256;
+
+        std::fill(c, c + 256, 0);
+        for (R_xlen_t i = lo; i < hi; ++i) {
+          ++c[(src[i] >> shift) & 0xFF];
+        }
+
+#pragma omp barrier
+#pragma omp single
+        {
+          R_xlen_t running = 0;
+          for (int b = 0; b < 256; ++b) {
+            const R_xlen_t bucket_start = running;
+            for (int u = 0; u < nt; ++u) {
+              R_xlen_t cnt = counts[u * 256 + b];
+              counts[u * 256 + b] = running;
+              running += cnt;
+            }
+            if (running - bucket_start == n) skip = true;
+          }
+        }
+
+        if (!skip) {
+          if (isrc != nullptr) {
+            for (R_xlen_t i = lo; i < hi; ++i) {
+              R_xlen_t to = c[(src[i] >> shift) & 0xFF]++;
+              dst[to] = src[i];
+              idst[to] = isrc[i];
+            }
+          } else {
+            for (R_xlen_t i = lo; i < hi; ++i) {
+              dst[c[(src[i] >> shift) & 0xFF]++] = src[i];
+            }
+          }
+        }
+      }
+
+      if (!skip) {
+        std::swap(src, dst);
+        std::swap(isrc, idst);
+      }
+    }
+  }
+#endif
+
+  if (src != keys) {
+    std::copy(src, src + n, keys);
+    if (idx != nullptr) std::copy(isrc, isrc + n, idx);
+  }
+}
+
+inline bool string_less(const char* a, const char* b) {
+  return a != b && std::strcmp(a, b) < 0;
+}
+
+// Stable MSD radix sort of the positions in `idx` by the bytes of `s[idx[i]]` from
+// `depth` onwards. `tmp` is scratch space of the same length.
+inline void msd_sort(const char* const* s, int* idx, int* tmp, R_xlen_t n, size_t depth,
+                     bool decreasing, bool parallel) {
+  while (true) {
+    if (n < small_threshold) {
+      if (decreasing) {
+        std::stable_sort(idx, idx + n, [&](int a, int b) {
+          return string_less(s[b] + depth, s[a] + depth);
+        });
+      } else {
+        std::stable_sort(idx, idx + n, [&](int a, int b) {
+          return string_less(s[a] + depth, s[b] + depth);
+        });
+      }
+      return;
+    }
+
+    // Bucket 0 collects the strings that end at `depth`; they are all equal
+    R_xlen_t count[256] = {0};
+    for (R_xlen_t i = 0; i < n; ++i) {
+      ++count[static_cast<unsigned char>(s[idx[i]][depth])];
+    }
+
+    const unsigned char first = static_cast<unsigned char>(s[idx[0]][depth]);
+    if (count[first] == n) {
+      if (first == 0) return;
+      ++depth;
+      continue;
+    }
+
+    R_xlen_t start[256];
+    R_xlen_t running = 0;
+    for (int j = 0; j < 256; ++j) {
+      const int b = decreasing ? 255 - j : j;
+      start[b] = running;
+      running += count[b];
+    }
+
+    R_xlen_t pos[256];
+    std::copy(start, start + 256, pos);
+    for (R_xlen_t i = 0; i < n; ++i) {
+      tmp[pos[static_cast<unsigned char>(s[idx[i]][depth])]++] = idx[i];
+    }
+    std::copy(tmp, tmp + n, idx);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+    for (int b = 1; b < 256; ++b) {
+      if (count[b] > 1) {
+        msd_sort(s, idx + start[b], tmp + start[b], count[b], depth + 1, decreasing,
+                 false);
+      }
+    }
+    (void)parallel;
+    return;
+  }
+}
+
+// Fills `out` with the 1-based order of `keys`
+template <typename Key>
+void order_keys(std::vector<Key>& keys, int* out, R_xlen_t n) {
+  for (R_xlen_t i = 0; i < n; ++i) out[i] = static_cast<int>(i);
+  lsd_sort(keys.data(), out, n);
+  for (R_xlen_t i = 0; i < n; ++i) ++out[i];
+}
+
+inline void check_order_length(R_xlen_t n) {
+  if (n > INT_MAX) {
+    stop("'order()' supports vectors of at most %d elements", INT_MAX);
+  }
+}
+
+inline std::vector<uint32_t> int_keys(const int* x, R_xlen_t n, bool decreasing,
+                                      bool na_last) {
+  std::vector<uint32_t> keys(n);
+#ifdef _OPENMP
+#pragma omp parallel for if (n >= parallel_threshold)
+#endif
+  for (R_xlen_t i = 0; i < n; ++i) {
+    keys[i] = int_key(x[i], decreasing, na_last);
+  }
+  return keys;
+}
+
+inline std::vector<uint64_t> double_keys(const double* x, R_xlen_t n, bool decreasing,
+                                         bool na_last) {
+  std::vector<uint64_t> keys(n);
+#ifdef _OPENMP
+#pragma omp parallel for if (n >= parallel_threshold)
+#endif
+  for (R_xlen_t i = 0; i < n; ++i) {
+    keys[i] = double_key(x[i], decreasing, na_last);
+  }
+  return keys;
+}
+
+inline writable::integers order_ints(const int* x, R_xlen_t n, bool decreasing,
+                                     bool na_last) {
+  check_order_length(n);
+  std::vector<uint32_t> keys = int_keys(x, n, decreasing, na_last);
+  writable::integers out(n);
+  order_keys(keys, out.begin(), n);
+  return out;
+}
+
+// Returns the 0-based order of `x`; `NA_STRING` gets a null pointer in the byte view
+inline std::vector<int> order_strings(const strings& x, bool decreasing, bool na_last,
+                                      bool c_locale) {
+  const R_xlen_t n = x.size();
+  SEXP data = x.data();
+
+  std::vector<const char*> s(n);
+  unwind_protect([&] {
+    for (R_xlen_t i = 0; i < n; ++i) {
+      SEXP chr = STRING_ELT(data, i);
+      s[i] = (chr == NA_STRING) ? nullptr
+             : c_locale         ? Rf_translateCharUTF8(chr)
+                                : Rf_translateChar(chr);
+    }
+  });
+
+  // Stable partition of the NA strings
+  std::vector<int> idx;
+  std::vector<int> na;
+  idx.reserve(n);
+  for (R_xlen_t i = 0; i < n; ++i) {
+    (s[i] == nullptr ? na : idx).push_back(static_cast<int>(i));
+  }
+
+  const R_xlen_t m = idx.size();
+  if (c_locale) {
+    std::vector<int> tmp(m);
+    msd_sort(s.data(), idx.data(), tmp.data(), m, 0, decreasing,
+             threads_for(m) > 1);
+  } else if (decreasing) {
+    std::stable_sort(idx.begin(), idx.end(),
+                     [&](int a, int b) { return std::strcoll(s[b], s[a]) < 0; });
+  } else {
+    std::stable_sort(idx.begin(), idx.end(),
+                     [&](int a, int b) { return std::strcoll(s[a], s[b]) < 0; });
+  }
+
+  if (na_last) {
+    idx.insert(idx.end(), na.begin(), na.end());
+  } else {
+    idx.insert(idx.begin(), na.begin(), na.end());
+  }
+  return idx;
+}
+
+}  // namespace radix
+}  // namespace detail
+
+// Returns the 1-based permutation that sorts `x`, as `order(x, method = "radix")`
+inline writable::integers order(const integers& x, bool decreasing = false,
+                                bool na_last = true) {
+  return detail::radix::order_ints(x.begin(), x.size(), decreasing, na_last);
+}
+
+inline writable::integers order(const logicals& x, bool decreasing = false,
+                                bool na_last = true) {
+  return detail::radix::order_ints(LOGICAL(x.data()), x.size(), decreasing, na_last);
+}
+
+inline writable::integers order(const doubles& x, bool decreasing = false,
+                                bool na_last = true) {
+  const R_xlen_t n = x.size();
+  detail::radix::check_order_length(n);
+  std::vector<uint64_t> keys =
+      detail::radix::double_keys(x.begin(), n, decreasing, na_last);
+  writable::integers out(n);
+  detail::radix::order_keys(keys, out.begin(), n);
+  return out;
+}
+
+// `c_locale = true` compares the UTF-8 bytes, as `method = "radix"` does; `false`
+// uses the collation of the current locale (`LC_COLLATE`).
+inline writable::integers order(const strings& x, bool decreasing = false,
+                                bool na_last = true, bool c_locale = true) {
+  detail::radix::check_order_length(x.size());
+  std::vector<int> idx = detail::radix::order_strings(x, decreasing, na_last, c_locale);
+  const R_xlen_t n = idx.size();
+  writable::integers out(n);
+  int* po = out.begin();
+  for (R_xlen_t i = 0; i < n; ++i) {
+    po[i] = idx[i] + 1;
+  }
+  return out;
+}
+
+// Returns a sorted copy of `x`. Unlike `base::sort()`, missing values are kept (last by
+// default) rather than dropped, and attributes are not carried over.
+inline writable::integers sort(const integers& x, bool decreasing = false,
+                               bool na_last = true) {
+  const R_xlen_t n = x.size();
+  std::vector<uint32_t> keys =
+      detail::radix::int_keys(x.begin(), n, decreasing, na_last);
+  detail::radix::lsd_sort<uint32_t>(keys.data(), nullptr, n);
+
+  writable::integers out(n);
+  int* po = out.begin();
+  for (R_xlen_t i = 0; i < n; ++i) {
+    po[i] = detail::radix::int_from_key(keys[i], decreasing, na_last);
+  }
+  return out;
+}
+
+inline writable::doubles sort(const doubles& x, bool decreasing = false,
+                              bool na_last = true) {
+  const R_xlen_t n = x.size();
+  const double* px = x.begin();
+
+  // The missing values keep their payloads (NA vs NaN) and their original order
+  std::vector<double> missing;
+  std::vector<uint64_t> keys;
+  keys.reserve(n);
+  for (R_xlen_t i = 0; i < n; ++i) {
+    if (CPP4R_UNLIKELY(ISNAN(px[i]))) {
+      missing.push_back(px[i]);
+    } else {
+      keys.push_back(detail::radix::double_key(px[i], decreasing, na_last));
+    }
+  }
+  const R_xlen_t m = keys.size();
+  detail::radix::lsd_sort<uint64_t>(keys.data(), nullptr, m);
+
+  writable::doubles out(n);
+  double* po = out.begin();
+  double* pv = na_last ? po : po + missing.size();
+  std::copy(missing.begin(), missing.end(), na_last ? po + m : po);
+#ifdef _OPENMP
+#pragma omp parallel for if (m >= detail::radix::parallel_threshold)
+#endif
+  for (R_xlen_t i = 0; i < m; ++i) {
+    pv[i] = detail::radix::double_from_key(keys[i], decreasing, na_last);
+  }
+  return out;
+}
+
+inline writable::strings sort(const strings& x, bool decreasing = false,
+                              bool na_last = true, bool c_locale = true) {
+  std::vector<int> idx = detail::radix::order_strings(x, decreasing, na_last, c_locale);
+  const R_xlen_t n = idx.size();
+  SEXP data = x.data();
+
+  writable::strings out(n);
+  SEXP out_data = out.data();
+  for (R_xlen_t i = 0; i < n; ++i) {
+    SET_STRING_ELT(out_data, i, STRING_ELT(data, idx[i]));
+  }
+  return out;
+}
+
+}  // namespace cpp4r
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <algorithm>  // for fill
+#include <cstdint>    // for uint8_t
+#include <vector>     // for vector
+
+#include "cpp4r/R.hpp"            // for SEXP, R_xlen_t, NA_INTEGER, NA_LOGICAL
+#include "cpp4r/complexes.hpp"    // for complexes
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_PREFETCH, CPP4R_LIKELY
+#include "cpp4r/doubles.hpp"      // for doubles
+#include "cpp4r/integers.hpp"     // for integers
+#include "cpp4r/logicals.hpp"     // for logicals
+#include "cpp4r/protect.hpp"      // for safe, stop, warning
+#include "cpp4r/raws.hpp"         // for raws
+#include "cpp4r/strings.hpp"      // for strings
+
+// Gather/scatter kernels with the semantics of R's `[` and `[<-` on atomic vectors:
+//
+//  - `subset(x, idx)` is `x[idx]` for an integer subscript: 1-based positions, zeros are
+//    dropped, `NA` and positions past the end give `NA`, and all-negative subscripts
+//    exclude elements. Positive and negative subscripts can't be mixed.
+//  - `subset_mask(x, mask)` is `x[mask]` for a logical subscript, recycling `mask` and
+//    giving `NA` for `NA` entries.
+//  - `assign_at(x, idx, values)` is `x[idx] <- values`, recycling `values` and growing
+//    `x` (with `NA`) when a position is past its end.
+//
+// As with the primitive `[`, the result keeps the (subsetted) names and drops every
+// other attribute. Subsetting by position prefetches the source elements a few
+// iterations ahead; masks are compressed without a data-dependent branch per element.
+
+namespace cpp4r {
+
+namespace detail {
+namespace subset {
+
+// How far ahead random gathers prefetch, in elements of the index vector
+constexpr R_xlen_t prefetch_distance = 16;
+
+// Raw element access per vector type. `set()` goes through `SET_STRING_ELT()` for
+// strings, which need the write barrier, and through the data pointer otherwise.
+template <typename T>
+struct elt;
+
+template <>
+struct elt<double> {
+  using type = double;
+  static const type* cptr(SEXP x) { return REAL(x); }
+  static type* ptr(SEXP x) { return REAL(x); }
+  static type na() { return NA_REAL; }
+  static void set(SEXP, type* p, R_xlen_t i, type v) { p[i] = v; }
+};
+
+template <>
+struct elt<int> {
+  using type = int;
+  static const type* cptr(SEXP x) { return INTEGER(x); }
+  static type* ptr(SEXP x) { return INTEGER(x); }
+  static type na() { return NA_INTEGER; }
+  static void set(SEXP, type* p, R_xlen_t i, type v) { p[i] = v; }
+};
+
+template <>
+struct elt<r_bool> {
+  using type = int;
+  static const type* cptr(SEXP x) { return LOGICAL(x); }
+  static type* ptr(SEXP x) { return LOGICAL(x); }
+  static type na() { return NA_LOGICAL; }
+  static void set(SEXP, type* p, R_xlen_t i, type v) { p[i] = v; }
+};
+
+template <>
+struct elt<uint8_t> {
+  using type = Rbyte;
+  static const type* cptr(SEXP x) { return RAW(x); }
+  static type* ptr(SEXP x) { return RAW(x); }
+  // R fills raw vectors with 00 where other types get NA
+  static type na() { return 0; }
+  static void set(SEXP, type* p, R_xlen_t i, type v) { p[i] = v; }
+};
+
+template <>
+struct elt<r_complex> {
+  using type = Rcomplex;
+  static const type* cptr(SEXP x) { return COMPLEX(x); }
+  static type* ptr(SEXP x) { return COMPLEX(x); }
+  static type na() {
+    Rcomplex out;
+    out.r = NA_REAL;
+    out.i = NA_REAL;
+    return out;
+  }
+  static void set(SEXP, type* p, R_xlen_t i, type v) { p[i] = v; }
+};
+
+template <>
+struct elt<r_string> {
+  using type = SEXP;
+  static const type* cptr(SEXP x) { return STRING_PTR_RO(x); }
+  static type* ptr(SEXP) { return nullptr; }
+  static type na() { return NA_STRING; }
+  static void set(SEXP x, type*, R_xlen_t i, type v) { SET_STRING_ELT(x, i, v); }
+};
+
+// One pass over an integer subscript
+struct subscript_info {
+  R_xlen_t zeros = 0;
+  R_xlen_t max = 0;
+  bool positive = false;
+  bool negative = false;
+  bool missing = false;
+};
+
+inline subscript_info classify(const int* idx, R_xlen_t m) {
+  subscript_info info;
+  for (R_xlen_t i = 0; i < m; ++i) {
+    const int j = idx[i];
+    if (j == NA_INTEGER) {
+      info.missing = true;
+    } else if (j > 0) {
+      info.positive = true;
+      if (j > info.max) info.max = j;
+    } else if (j < 0) {
+      info.negative = true;
+    } else {
+      ++info.zeros;
+    }
+  }
+  if (info.negative && (info.positive || info.missing)) {
+    stop("can't mix positive and negative subscripts");
+  }
+  return info;
+}
+
+// `x[idx]` for a non-negative subscript; `out` has length `m - zeros`
+template <typename T>
+void gather(SEXP x, R_xlen_t n, const int* idx, R_xlen_t m, SEXP out) {
+  using E = elt<T>;
+  const typename E::type* CPP4R_RESTRICT src = E::cptr(x);
+  typename E::type* dst = E::ptr(out);
+  const typename E::type na = E::na();
+
+  R_xlen_t k = 0;
+  for (R_xlen_t i = 0; i < m; ++i) {
+    if (CPP4R_LIKELY(i + prefetch_distance < m)) {
+      const int ahead = idx[i + prefetch_distance];
+      if (ahead > 0 && ahead <= n) {
+        CPP4R_PREFETCH(src + ahead - 1);
+      }
+    }
+    const int j = idx[i];
+    if (j == 0) {
+      continue;
+    }
+    E::set(out, dst, k++, (j != NA_INTEGER && j <= n) ? src[j - 1] : na);
+  }
+}
+
+// Selects the elements of `x` whose (recycled) mask entry is TRUE, and `NA` where it is
+// NA; positions past the end of `x` give `NA`. `out` has the length returned by
+// `mask_size()`.
+template <typename T, typename M>
+void compress(SEXP x, R_xlen_t n, const M* mask, R_xlen_t mask_n, M na_mask,
+              R_xlen_t out_n, bool has_na, SEXP out) {
+  using E = elt<T>;
+  const typename E::type* CPP4R_RESTRICT src = E::cptr(x);
+  typename E::type* CPP4R_RESTRICT dst = E::ptr(out);
+
+  if (dst != nullptr && !has_na && mask_n == n) {
+    // Branch-free compress: always store, only advance on TRUE. The loop stops at the
+    // last selected element, so the unconditional store never runs past `out_n`.
+    R_xlen_t k = 0;
+    for (R_xlen_t i = 0; k < out_n; ++i) {
+      dst[k] = src[i];
+      k += (mask[i] != 0);
+    }
+    return;
+  }
+
+  const typename E::type na = E::na();
+  const R_xlen_t len = n > mask_n ? n : mask_n;
+  R_xlen_t k = 0;
+  R_xlen_t im = 0;
+  for (R_xlen_t i = 0; i < len; ++i) {
+    const M v = mask[im];
+    if (++im == mask_n) im = 0;
+    if (v == 0) {
+      continue;
+    }
+    E::set(out, dst, k++, (v != na_mask && i < n) ? src[i] : na);
+  }
+}
+
+template <typename M>
+R_xlen_t mask_size(R_xlen_t n, const M* mask, R_xlen_t mask_n, M na_mask, bool* has_na) {
+  R_xlen_t selected = 0;
+  bool any_na = false;
+  for (R_xlen_t i = 0; i < mask_n; ++i) {
+    selected += (mask[i] != 0);
+    any_na |= (mask[i] == na_mask);
+  }
+  *has_na = any_na;
+  if (mask_n >= n || mask_n == 0) {
+    return selected;
+  }
+  // Recycled mask: full repetitions plus the leading part of the last one
+  const R_xlen_t reps = n / mask_n;
+  const R_xlen_t rest = n % mask_n;
+  R_xlen_t out = selected * reps;
+  for (R_xlen_t i = 0; i < rest; ++i) {
+    out += (mask[i] != 0);
+  }
+  return out;
+}
+
+// Subsets `x` (and its names) by a subscript, returning a fresh unprotected vector
+template <typename T>
+SEXP subset_by_index(SEXP x, R_xlen_t n, const int* idx, R_xlen_t m) {
+  const subscript_info info = classify(idx, m);
+  const SEXPTYPE type = TYPEOF(x);
+
+  if (!info.negative) {
+    SEXP out = PROTECT(safe[Rf_allocVector](type, m - info.zeros));
+    gather<T>(x, n, idx, m, out);
+
+    SEXP names = Rf_getAttrib(x, R_NamesSymbol);
+    if (names != R_NilValue) {
+      SEXP out_names = PROTECT(safe[Rf_allocVector](STRSXP, m - info.zeros));
+      gather<r_string>(names, n, idx, m, out_names);
+      Rf_setAttrib(out, R_NamesSymbol, out_names);
+      UNPROTECT(1);
+    }
+
+    UNPROTECT(1);
+    return out;
+  }
+
+  // Exclusion: compress by a keep-mask
+  std::vector<unsigned char> keep(n, 1);
+  R_xlen_t kept = n;
+  for (R_xlen_t i = 0; i < m; ++i) {
+    const R_xlen_t j = -static_cast<R_xlen_t>(idx[i]);
+    if (j > 0 && j <= n && keep[j - 1]) {
+      keep[j - 1] = 0;
+      --kept;
+    }
+  }
+
+  SEXP out = PROTECT(safe[Rf_allocVector](type, kept));
+  compress<T, unsigned char>(x, n, keep.data(), n, 2, kept, false, out);
+
+  SEXP names = Rf_getAttrib(x, R_NamesSymbol);
+  if (names != R_NilValue) {
+    SEXP out_names = PROTECT(safe[Rf_allocVector](STRSXP, kept));
+    compress<r_string, unsigned char>(names, n, keep.data(), n, 2, kept, false,
+                                      out_names);
+    Rf_setAttrib(out, R_NamesSymbol, out_names);
+    UNPROTECT(1);
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+template <typename T>
+SEXP subset_by_mask(SEXP x, R_xlen_t n, const int* mask, R_xlen_t mask_n) {
+  SEXP names = Rf_getAttrib(x, R_NamesSymbol);
+
+  // `x[logical(0)]` is empty; there is no mask to recycle
+  if (mask_n == 0) {
+    SEXP out = PROTECT(safe[Rf_allocVector](TYPEOF(x), 0));
+    if (names != R_NilValue) {
+      Rf_setAttrib(out, R_NamesSymbol, safe[Rf_allocVector](STRSXP, 0));
+    }
+    UNPROTECT(1);
+    return out;
+  }
+
+  bool has_na = false;
+  const R_xlen_t out_n = mask_size(n, mask, mask_n, NA_LOGICAL, &has_na);
+
+  SEXP out = PROTECT(safe[Rf_allocVector](TYPEOF(x), out_n));
+  compress<T, int>(x, n, mask, mask_n, NA_LOGICAL, out_n, has_na, out);
+
+  if (names != R_NilValue) {
+    SEXP out_names = PROTECT(safe[Rf_allocVector](STRSXP, out_n));
+    compress<r_string, int>(names, n, mask, mask_n, NA_LOGICAL, out_n, has_na,
+                            out_names);
+    Rf_setAttrib(out, R_NamesSymbol, out_names);
+    UNPROTECT(1);
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+}  // namespace subset
+}  // namespace detail
+
+template <typename T>
+writable::r_vector<T> subset(const r_vector<T>& x, const integers& idx) {
+  SEXP out = detail::subset::subset_by_index<T>(x.data(), x.size(), INTEGER(idx.data()),
+                                                idx.size());
+  return writable::r_vector<T>(out, writable::fresh_allocation_tag{});
+}
+
+template <typename T>
+writable::r_vector<T> subset_mask(const r_vector<T>& x, const logicals& mask) {
+  SEXP out = detail::subset::subset_by_mask<T>(x.data(), x.size(),
+                                               LOGICAL(mask.data()), mask.size());
+  return writable::r_vector<T>(out, writable::fresh_allocation_tag{});
+}
+
+// `x[idx] <- values`, modifying `x` in place
+template <typename T>
+void assign_at(writable::r_vector<T>& x, const integers& idx, const r_vector<T>& values) {
+  using E = detail::subset::elt<T>;
+
+  const int* pidx = INTEGER(idx.data());
+  const R_xlen_t m = idx.size();
+  const detail::subset::subscript_info info = detail::subset::classify(pidx, m);
+  const R_xlen_t nv = values.size();
+  const R_xlen_t n = x.size();
+
+  if (info.missing && nv > 1) {
+    stop("NAs are not allowed in subscripted assignments");
+  }
+
+  // Number of elements that will be replaced, to check the recycling of `values`
+  R_xlen_t targets = 0;
+  std::vector<unsigned char> keep;
+  if (info.negative) {
+    keep.assign(n, 1);
+    targets = n;
+    for (R_xlen_t i = 0; i < m; ++i) {
+      const R_xlen_t j = -static_cast<R_xlen_t>(pidx[i]);
+      if (j > 0 && j <= n && keep[j - 1]) {
+        keep[j - 1] = 0;
+        --targets;
+      }
+    }
+  } else {
+    for (R_xlen_t i = 0; i < m; ++i) {
+      targets += (pidx[i] > 0);
+    }
+  }
+
+  if (targets == 0) {
+    return;
+  }
+  if (nv == 0) {
+    stop("replacement has length zero");
+  }
+  if (targets % nv != 0) {
+    warning("number of items to replace is not a multiple of replacement length");
+  }
+
+  // Grow `x` with `NA` (names with `""`) when assigning past the end
+  if (!info.negative && info.max > n) {
+    x.resize(info.max);
+    SEXP data = x;
+    typename E::type* p = E::ptr(data);
+    const typename E::type na = E::na();
+    for (R_xlen_t i = n; i < info.max; ++i) {
+      E::set(data, p, i, na);
+    }
+  }
+
+  // Converting to `SEXP` truncates any spare capacity left by `push_back()`
+  SEXP data = x;
+  typename E::type* dst = E::ptr(data);
+  const typename E::type* src = E::cptr(values.data());
+
+  R_xlen_t k = 0;
+  if (info.negative) {
+    for (R_xlen_t i = 0; i < n; ++i) {
+      if (keep[i]) {
+        E::set(data, dst, i, src[k]);
+        if (++k == nv) k = 0;
+      }
+    }
+    return;
+  }
+
+  for (R_xlen_t i = 0; i < m; ++i) {
+    if (CPP4R_LIKELY(i + detail::subset::prefetch_distance < m)) {
+      const int ahead = pidx[i + detail::subset::prefetch_distance];
+      if (ahead > 0 && dst != nullptr) {
+        CPP4R_PREFETCH_WRITE(dst + ahead - 1);
+      }
+    }
+    const int j = pidx[i];
+    if (j <= 0) {
+      // Zero, or an NA with a single value, which R skips
+      continue;
+    }
+    E::set(data, dst, j - 1, src[k]);
+    if (++k == nv) k = 0;
+  }
+}
+
+}  // namespace cpp4r
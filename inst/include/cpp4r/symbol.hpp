@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>  // for string
+
+#include "cpp4r/R.hpp"            // for SEXP, Rf_install, PRINTNAME
+#include "cpp4r/cpp_version.hpp"  // for CPP4R_HAS_CXX20
+#include "cpp4r/protect.hpp"      // for safe, detail::fixed_string
+
+// R symbols, installed once.
+//
+// Looking a name up with a `const char*` (`environment::operator[]`, `exists()`,
+// `package::operator[]`, the tags of `named_arg`) calls `Rf_install()` each time, which
+// hashes the name into R's symbol table. A `symbol` holds the installed SEXP instead:
+// keep it in a `static` and pass it wherever a symbol is expected, and the lookup is a
+// pointer comparison. Symbols are never garbage collected, so they need no protection.
+//
+// From C++20, `sym<"x">()` or the `"x"_sym` literal install each name once per process:
+//
+//   env["x"_sym] = 1;
+
+namespace cpp4r {
+
+class symbol {
+ public:
+  explicit symbol(const char* name) : data_(safe[Rf_install](name)) {}
+  explicit symbol(const std::string& name) : symbol(name.c_str()) {}
+
+  const char* name() const { return CHAR(PRINTNAME(data_)); }
+
+  operator SEXP() const noexcept { return data_; }
+
+  bool operator==(const symbol& rhs) const noexcept { return data_ == rhs.data_; }
+  bool operator!=(const symbol& rhs) const noexcept { return data_ != rhs.data_; }
+
+ private:
+  SEXP data_;
+};
+
+#if CPP4R_HAS_CXX20
+// The symbol called `Name`, installed on first use
+template <detail::fixed_string Name>
+const symbol& sym() {
+  static const symbol out(Name.value);
+  return out;
+}
+
+namespace literals {
+
+template <detail::fixed_string Name>
+const symbol& operator""_sym() {
+  return sym<Name>();
+}
+
+}  // namespace literals
+#endif
+
+}  // namespace cpp4r